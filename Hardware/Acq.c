@@ -0,0 +1,387 @@
+#include "Acq.h"
+#include <string.h>
+
+#define ACQ_CURRENT_REG  0x04
+#define ACQ_MASK_REG     0x06
+
+#if ACQ_ALERT
+#define ACQ_FIRST_REG    ACQ_MASK_REG     //先读Mask/Enable放开ALERT
+#else
+#define ACQ_FIRST_REG    ACQ_CURRENT_REG
+#endif
+
+//挂起位和开始传输在pTMR、GPIO、I2C三个中断里都会改，优先级不一样时会互相打断
+#define ACQ_LOCK()    uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define ACQ_UNLOCK()  __set_PRIMASK(primask)
+
+static Acq_t *Acq_Bus;           //回调里用，I2C1上只有一个采集
+
+/*
+	按配置表探测和配置每个INA226，返回探测到的通道数
+	用的是阻塞读写，要在采集开始前做完；ACQ_ALERT时还要把ALERT配成转换完成，再配好引脚的下降沿中断
+*/
+unsigned char Acq_Init(Acq_t *a,const Acq_Config_t *cfg,uint8_t n)
+{
+	unsigned char i,found = 0;
+	uint32_t us;
+
+	memset(a,0,sizeof(*a));
+	a->n = n > ACQ_DEVS ? ACQ_DEVS : n;
+	for(i=0;i<a->n;i++)
+	{
+		Acq_Dev_t *d = &a->dev[i];
+
+		AutoFox_INA226_Constructor(&d->ina);
+		d->ptr = ACQ_PTR_NONE;
+		d->init = AutoFox_INA226_Init(&d->ina,cfg[i].addr,cfg[i].shunt_uohms,cfg[i].max_ua);
+		if(d->init == OK)
+			d->init = AutoFox_INA226_ConfigureNumSampleAveraging(&d->ina,cfg[i].avg);
+		if(d->init == OK)
+			d->init = AutoFox_INA226_ConfigureVoltageConversionTime(&d->ina,cfg[i].conv);
+#if ACQ_ALERT
+		if(d->init == OK)
+		{
+			enum eAlertTriggerCause cause;
+
+			d->init = AutoFox_INA226_ConfigureAlertPinTrigger(&d->ina,ConversionReady,0,false);
+			AutoFox_INA226_ResetAlertPin(&d->ina,&cause);
+		}
+#endif
+		if(d->init != OK)
+		{
+			PRINTF("Acq: ch%d INA226 @0x%02X not found (%d)\r\n",i,cfg[i].addr,d->init);
+			continue;
+		}
+		//定时读的间隔向上取整到tick，不会在新结果出来前读
+		us = cfg[i].period_ms ? cfg[i].period_ms*1000UL : AutoFox_INA226_GetConversionPeriod_us(&d->ina);
+		us = (us + ACQ_TICK_MS*1000UL - 1) / (ACQ_TICK_MS*1000UL);
+		d->period = us == 0 ? 1 : us > 255 ? 255 : (uint8_t)us;
+		d->count = 1 + i;                 //错开一个tick，几个通道不在同一个tick里挂起
+		a->present |= 1 << i;
+		found++;
+	}
+	Acq_Bus = a;
+#if ACQ_ALERT
+	PINS_DRV_SetMuxModeSel(ACQ_ALERT_PCTRL,ACQ_ALERT_PIN,PCTRL_MUX_AS_GPIO);
+	PINS_DRV_SetPullSel(ACQ_ALERT_PCTRL,ACQ_ALERT_PIN,PCTRL_INTERNAL_PULL_UP_ENABLED);
+	PINS_DRV_SetPinDirection(ACQ_ALERT_GPIO,ACQ_ALERT_PIN,GPIO_INPUT_DIRECTION);
+	PINS_DRV_ClearPinIntFlagCmd(ACQ_ALERT_GPIO,ACQ_ALERT_PIN);
+	PINS_DRV_SetPinIntSel(ACQ_ALERT_GPIO,ACQ_ALERT_PIN,PCTRL_INT_FALLING_EDGE);
+	INT_SYS_EnableIRQ(GPIO_IRQn);
+#endif
+	return found;
+}
+
+//读当前通道的寄存器reg，它的指针已经指着reg就直接读
+static status_t Acq_Start(Acq_t *a,uint8_t reg)
+{
+	a->reg = reg;
+	if(a->dev[a->cur].ptr == reg)
+	{
+		a->state = ACQ_READ;          //先改状态，I2C中断可能在启动函数返回前就来
+		return I2C_DRV_MasterReceiveData(ACQ_I2C,a->rx,2,true);
+	}
+	a->tx = reg;
+	a->state = ACQ_PTR;
+	return I2C_DRV_MasterSendData(ACQ_I2C,&a->tx,1,false);   //不发STOP，接着重复起始读
+}
+
+/*
+	总线空闲时从上一个通道的下一个开始，找一个挂起的通道换地址开始读
+	一个启动失败就记到它的error上，接着试下一个
+*/
+static void Acq_Next(Acq_t *a)
+{
+	uint8_t i,ch;
+
+	for(;;)
+	{
+		ACQ_LOCK();
+		if(a->state != ACQ_IDLE || a->pending == 0 || a->hold || a->burst)
+		{
+			ACQ_UNLOCK();
+			return;
+		}
+		ch = a->cur;
+		for(i=0;i<a->n;i++)
+		{
+			ch = ch+1 >= a->n ? 0 : ch+1;
+			if(a->pending & (1 << ch))
+				break;
+		}
+		a->pending &= ~(1 << ch);
+		a->cur = ch;
+		a->state = ACQ_PTR;           //先占住总线，别的中断进来不会再开始一个
+		ACQ_UNLOCK();
+
+		I2C_DRV_MasterSetSlaveAddr(ACQ_I2C,a->dev[ch].ina.mI2C_Address,false);
+		if(Acq_Start(a,ACQ_FIRST_REG) == STATUS_SUCCESS)
+			return;
+		a->dev[ch].error++;
+		a->state = ACQ_IDLE;
+	}
+}
+
+//挂起几个通道，已经挂着的记一次busy
+static void Acq_Pend(Acq_t *a,uint8_t mask)
+{
+	uint8_t i;
+	ACQ_LOCK();
+	for(i=0;i<a->n;i++)
+		if(mask & a->pending & (1 << i))
+			a->dev[i].busy++;
+	a->pending |= mask;
+	ACQ_UNLOCK();
+	Acq_Next(a);
+}
+
+/*
+	pTMR通道0中断里每ACQ_TICK_MS调用
+	ACQ_ALERT 0: 每个通道数到自己的period就挂起
+	ACQ_ALERT 1: 连着两次看到ALERT低着又没在读，说明下降沿不会再来了，补读一次
+*/
+void Acq_Tick(Acq_t *a)
+{
+	if(a->burst)
+		return;
+#if ACQ_ALERT
+	if(a->state == ACQ_IDLE && a->pending == 0 && (PINS_DRV_ReadPins(ACQ_ALERT_GPIO) & (1U << ACQ_ALERT_PIN)) == 0)
+	{
+		if(a->tick)
+		{
+			a->missed++;
+			a->rounds = 0;
+			Acq_Pend(a,a->present);
+		}
+		a->tick = 1;
+	}
+	else
+		a->tick = 0;
+#else
+	uint8_t i,due = 0;
+
+	for(i=0;i<a->n;i++)
+	{
+		Acq_Dev_t *d = &a->dev[i];
+		if((a->present & (1 << i)) && --d->count == 0)
+		{
+			d->count = d->period;
+			due |= 1 << i;
+		}
+	}
+	if(due)
+		Acq_Pend(a,due);
+#endif
+}
+
+/*
+	GPIO中断里调用: 线与的ALERT拉低了，不知道是哪个芯片转换完了，所有通道都挂起
+	每个通道先读Mask/Enable，CVRF没置位的只花这一次读
+*/
+void Acq_Alert(Acq_t *a)
+{
+	a->rounds = 0;
+	Acq_Pend(a,a->present);
+}
+
+#if ACQ_ALERT
+/*
+	I2C中断里，一个通道读完以后: 挂起的都读完了ALERT还低着，说明这一轮里又有芯片转换完了
+	它拉着线，下降沿不会再来，所有通道再挂起一轮
+*/
+static void Acq_Recheck(Acq_t *a)
+{
+	ACQ_LOCK();
+	if(a->pending == 0 && a->rounds < ACQ_DEVS && (PINS_DRV_ReadPins(ACQ_ALERT_GPIO) & (1U << ACQ_ALERT_PIN)) == 0)
+	{
+		a->rounds++;
+		a->pending = a->present;
+	}
+	ACQ_UNLOCK();
+}
+#endif
+
+//I2C中断里: 换算成uA放进环形缓冲，满了就丢掉新的
+static void Acq_Push(Acq_t *a)
+{
+	uint8_t head = a->head;
+	Acq_Sample_t *s;
+
+	if((uint8_t)(head - a->tail) >= ACQ_RING)
+	{
+		a->lost++;
+		return;
+	}
+	s = &a->ring[head & (ACQ_RING-1)];
+	s->time = OSIF_GetMilliseconds();
+	s->value = (int32_t)(int16_t)((a->rx[0] << 8) | a->rx[1]) * a->dev[a->cur].ina.mCurrentMicroAmpsPerBit;
+	s->ch = a->cur;
+	__DMB();                          //样本写完再挪head
+	a->head = head+1;
+}
+
+/*
+	I2C_MasterConfig0的masterCallback，在I2C1中断里调用
+	采集没在传输时(初始化时的阻塞读写)什么都不做
+	一个通道读完或出错都紧接着开始下一个挂起的通道
+*/
+void Acq_I2cCallback(i2c_master_event_t event,void *param)
+{
+	Acq_t *a = Acq_Bus;
+	Acq_Dev_t *d;
+	(void)param;
+
+	if(a == NULL || a->state == ACQ_IDLE)
+		return;
+	d = &a->dev[a->cur];
+	if(event == I2C_MASTER_EVENT_TX_END && a->state == ACQ_PTR)
+	{
+		d->ptr = a->reg;
+		a->state = ACQ_READ;
+		if(I2C_DRV_MasterReceiveData(ACQ_I2C,a->rx,2,true) == STATUS_SUCCESS)
+			return;
+		d->error++;
+	}
+	else if(event == I2C_MASTER_EVENT_RX_END && a->state == ACQ_READ)
+	{
+		if(a->burst)
+		{
+			//突发抓取: 原始值直接给Scope，不要了就停掉定时器
+			if(Scope_Add(a->scope,(int16_t)((a->rx[0] << 8) | a->rx[1])))
+				pTMR_DRV_StopTimerChannels(0,ACQ_BURST_CH);
+			a->state = ACQ_IDLE;
+			return;
+		}
+		if(a->reg == ACQ_MASK_REG)
+		{
+			//读Mask/Enable已经放开了这个芯片的ALERT，CVRF置位才有新的电流值
+			if((a->rx[1] & ConversionReadyFlag) == 0)
+				d->spurious++;
+			else if(Acq_Start(a,ACQ_CURRENT_REG) == STATUS_SUCCESS)
+				return;
+			else
+				d->error++;
+		}
+		else
+			Acq_Push(a);
+	}
+	else
+	{
+		d->error++;                   //NACK、仲裁丢失、FIFO错、SCL超时: 这个通道下次从写指针重新开始
+		d->ptr = ACQ_PTR_NONE;
+	}
+	a->state = ACQ_IDLE;
+#if ACQ_ALERT
+	Acq_Recheck(a);
+#endif
+	Acq_Next(a);
+}
+
+/*
+	主循环里调用: 停止开始新的传输，等当前这个结束
+	I2C卡住超过ACQ_HOLD_MS就中止传输，芯片的指针状态不知道了
+*/
+static void Acq_Hold(Acq_t *a)
+{
+	uint32_t t0 = OSIF_GetMilliseconds();
+
+	a->hold = 1;
+	while(a->state != ACQ_IDLE)
+	{
+		if(OSIF_GetMilliseconds() - t0 > ACQ_HOLD_MS)
+		{
+			I2C_DRV_MasterAbortTransferData(ACQ_I2C);
+			a->dev[a->cur].ptr = ACQ_PTR_NONE;
+			a->dev[a->cur].error++;
+			a->state = ACQ_IDLE;
+		}
+	}
+}
+
+/*
+	主循环里调用: 通道ch切到最快，开始给scope突发读
+	用阻塞读写改INA226的配置(约1ms)，通道不在或正在突发返回0
+*/
+unsigned char Acq_BurstStart(Acq_t *a,uint8_t ch,Scope_t *scope)
+{
+	Acq_Dev_t *d;
+
+	if(ch >= a->n || !(a->present & (1 << ch)) || a->burst)
+		return 0;
+	d = &a->dev[ch];
+	Acq_Hold(a);
+#if ACQ_ALERT
+	INT_SYS_DisableIRQ(GPIO_IRQn);    //140us一次转换完成，ALERT不用了
+#endif
+	a->burst_config = d->ina.mConfigRegister;
+	AutoFox_INA226_ConfigureNumSampleAveraging(&d->ina,0);     //1次平均
+	AutoFox_INA226_ConfigureVoltageConversionTime(&d->ina,0);  //140us
+	AutoFox_INA226_SetOperatingMode(&d->ina,ShuntVoltageContinuous);   //不测总线电压，140us出一个电流值
+	d->ptr = ACQ_PTR_NONE;
+	Scope_Start(scope,d->ina.mCurrentMicroAmpsPerBit,ACQ_BURST_US);
+	a->scope = scope;
+	a->cur = ch;
+	a->pending = 0;
+	a->overrun = 0;
+	I2C_DRV_MasterSetSlaveAddr(ACQ_I2C,d->ina.mI2C_Address,false);
+	a->burst = 1;
+	a->hold = 0;
+	pTMR_DRV_StartTimerChannels(0,ACQ_BURST_CH);
+	return 1;
+}
+
+//pTMR通道ACQ_BURST_CH的中断里调用，读一次电流寄存器(指针第一次以后一直指着它)
+void Acq_BurstTick(Acq_t *a)
+{
+	ACQ_LOCK();
+	if(!a->burst || a->state != ACQ_IDLE)
+	{
+		if(a->burst)
+			a->overrun++;
+		ACQ_UNLOCK();
+		return;
+	}
+	a->state = ACQ_PTR;
+	ACQ_UNLOCK();
+	if(Acq_Start(a,ACQ_CURRENT_REG) != STATUS_SUCCESS)
+	{
+		a->dev[a->cur].error++;
+		a->state = ACQ_IDLE;
+	}
+}
+
+/*
+	主循环里调用: Scope抓完或者不要了以后，把芯片配置写回去，恢复定时读/ALERT
+*/
+void Acq_BurstStop(Acq_t *a)
+{
+	Acq_Dev_t *d = &a->dev[a->cur];
+	enum eAlertTriggerCause cause;
+
+	if(!a->burst)
+		return;
+	pTMR_DRV_StopTimerChannels(0,ACQ_BURST_CH);
+	Acq_Hold(a);
+	a->burst = 0;
+	AutoFox_INA226_SetConfigRegister(&d->ina,a->burst_config);
+	AutoFox_INA226_ResetAlertPin(&d->ina,&cause);   //突发时转换完成没人读，放开ALERT
+	d->ptr = ACQ_PTR_NONE;
+#if ACQ_ALERT
+	PINS_DRV_ClearPinIntFlagCmd(ACQ_ALERT_GPIO,ACQ_ALERT_PIN);
+	INT_SYS_EnableIRQ(GPIO_IRQn);
+#endif
+	a->hold = 0;
+}
+
+//主循环里取一个样本，没有了返回0
+unsigned char Acq_Get(Acq_t *a,Acq_Sample_t *s)
+{
+	uint8_t tail = a->tail;
+
+	if(tail == a->head)
+		return 0;
+	*s = a->ring[tail & (ACQ_RING-1)];
+	__DMB();                          //样本拷完再挪tail，中断才能覆盖这个位置
+	a->tail = tail+1;
+	return 1;
+}
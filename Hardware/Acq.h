@@ -0,0 +1,115 @@
+#ifndef ACQ_H
+#define ACQ_H
+
+#include "sdk_project_config.h"
+#include "Autofox_INA226_c.h"
+#include "Scope.h"
+
+/*
+	I2C1上几个INA226的电流采集，不阻塞
+	启动时Acq_Init按配置表逐个探测(读ID)、复位、配置平均次数和转换时间、写校准，没应答的通道不排进调度
+	每个通道有自己的寄存器指针、转换周期和计数，到时间就挂起一次读；
+	I2C空闲时按轮询顺序挑下一个挂起的通道，换从机地址开始读，后面的步骤都在I2C中断(Acq_I2cCallback)里接着做:
+		写寄存器指针(这个芯片的指针已经指着要读的寄存器就省掉) -> 读2字节 -> 下一个寄存器或者换算成uA，带通道和时间放进环形缓冲
+		-> 还有挂起的通道就紧接着读下一个
+	谁来挂起:
+		ACQ_ALERT 0  pTMR通道0中断里的Acq_Tick，每个通道按它的转换周期(或配置表里的period_ms)，只读电流寄存器
+		ACQ_ALERT 1  所有INA226的ALERT(开漏)线与到ACQ_ALERT_PIN，配成转换完成，下降沿进GPIO中断(Acq_Alert)挂起所有通道:
+		             每个通道先读Mask/Enable(放开自己的ALERT，CVRF置位才是它转换完了)，再读电流寄存器
+		             转换完成的ALERT只有读Mask/Enable(或写配置寄存器)才放开，指针每次要在两个寄存器间来回换，
+		             一次转换是 写指针+读 两遍共4次传输；换成只读电流寄存器ALERT就一直低着，再也没有下降沿
+		             线与的ALERT只要有一个芯片拉着就不会有新的下降沿: 一轮读下来线还低着(读的时候别的芯片又转换完了)，
+		             I2C中断里紧接着再读一轮，每个下降沿最多再读ACQ_DEVS轮
+		             Acq_Tick只管ALERT一直低着的情况(边沿丢了、上次读出错或者多读几轮还放不开)，补读一次
+	突发抓取(Acq_BurstStart): 一个通道切到最快(1次平均 140us 只测分流)，pTMR通道ACQ_BURST_CH每ACQ_BURST_US读一次，
+		样本不进环形缓冲，直接给Scope_Add；其他通道的定时读和ALERT都停下，总线全给这一路
+		Scope抓完或被停掉以后主循环调Acq_BurstStop，把这个芯片的配置写回去，恢复轮询
+	环形缓冲只有I2C中断写、主循环(Acq_Get)读；挂起位和开始传输要在几个中断里改，改的时候关一下中断
+	Acq_Init以后I2C1归采集用，不能再调AutoFox_INA226_xxx的阻塞读写(会返回BUSY)
+*/
+
+#ifndef ACQ_ALERT
+#define ACQ_ALERT      0         //1: 由INA226的ALERT引脚(转换完成)触发  0: 定时读，板子上ALERT没接到ACQ_ALERT_PIN时用这个
+#endif
+#define ACQ_ALERT_PCTRL PCTRLD   //ALERT接的引脚，开漏低有效，用内部上拉
+#define ACQ_ALERT_GPIO  GPIOD
+#define ACQ_ALERT_PIN   5
+
+#define ACQ_DEVS       3         //通道数，和界面上的Current[3]对应
+#define ACQ_I2C        1         //INA226所在的I2C实例，回调在I2C_MasterConfig0的masterCallback
+#define ACQ_TICK_MS    10        //pTMR通道0的周期，Acq_Tick在它的中断里调
+#define ACQ_RING       32        //环形缓冲的样本数，2的幂
+#define ACQ_BURST_CH   2         //突发抓取用的pTMR通道，中断里调Acq_BurstTick
+#define ACQ_BURST_US   140       //突发抓取的读间隔，等于INA226最快的一次转换(ptmr_channel_2的周期)
+#define ACQ_HOLD_MS    5         //停下采集时等当前传输结束最多多久，超时就中止传输
+
+#define ACQ_IDLE  0              //没有传输
+#define ACQ_PTR   1              //正在写寄存器指针
+#define ACQ_READ  2              //正在读2字节
+
+#define ACQ_PTR_NONE  0xFF       //不知道INA226的寄存器指针在哪(刚开始、阻塞读写以后、出错以后)
+
+typedef struct
+{
+	uint8_t addr;                //7位I2C地址，A0/A1接法决定，0x40~0x4F
+	uint32_t shunt_uohms;        //分流电阻 微欧
+	int32_t max_ua;              //量程 uA，决定电流LSB
+	uint8_t avg;                 //平均次数的表索引 0~7: 1 4 16 64 128 256 512 1024
+	uint8_t conv;                //转换时间的表索引 0~7: 140 204 332 588 1100 2116 4156 8244us，分流和总线一样
+	uint16_t period_ms;          //定时读的间隔，0: 每次转换完读一次(按平均次数和转换时间算)
+} Acq_Config_t;
+
+typedef struct
+{
+	uint32_t time;               //读完的时间 ms
+	int32_t value;               //电流 uA
+	uint8_t ch;                  //通道，Acq_Init配置表的下标
+} Acq_Sample_t;
+
+typedef struct
+{
+	AutoFox_INA226 ina;
+	uint8_t ptr;                 //这个芯片的寄存器指针现在指着哪个寄存器，ACQ_PTR_NONE: 不知道
+	uint8_t period;              //定时读的间隔 tick
+	uint8_t count;               //离下次读还有几个tick
+	status init;                 //Acq_Init探测和配置的结果，OK才排进调度
+	volatile uint16_t busy;      //该读下一次了上一次还没读上，这次合并掉
+	volatile uint16_t error;     //NACK、仲裁丢失、超时等
+	volatile uint16_t spurious;  //ACQ_ALERT: 挂起了但CVRF没置位，没读电流
+} Acq_Dev_t;
+
+typedef struct
+{
+	Acq_Dev_t dev[ACQ_DEVS];
+	uint8_t n;                   //配置表里的通道数
+	uint8_t present;             //探测到的通道，第i位是通道i
+	volatile uint8_t pending;    //该读了还没开始读的通道
+	volatile uint8_t state;      //ACQ_xxx
+	uint8_t cur;                 //正在读(或者刚读完)的通道
+	uint8_t reg;                 //这次传输读的寄存器
+	uint8_t tx;                  //写指针用的字节，传输完之前不能动
+	uint8_t rx[2];
+	uint8_t tick;                //ACQ_ALERT: ALERT连着低了几个tick
+	uint8_t rounds;              //ACQ_ALERT: 这个下降沿以后ALERT还低着，又读了几轮
+	volatile uint8_t hold;       //1: 主循环要用阻塞读写，不开始新的传输
+	volatile uint8_t burst;      //1: 突发抓取中，只读cur这一路
+	uint16_t burst_config;       //突发前cur那个芯片的配置寄存器，结束时写回去
+	Scope_t *scope;              //突发抓取的样本给它
+	volatile uint16_t overrun;   //突发抓取: 到时间了上一次还没读完，少一个点
+	volatile uint8_t head;       //下一个要写的位置，只有中断改
+	volatile uint8_t tail;       //下一个要读的位置，只有主循环改
+	volatile uint16_t lost;      //缓冲满了丢掉的样本数
+	volatile uint16_t missed;    //ACQ_ALERT: ALERT一直低着，由Acq_Tick补读的次数
+	Acq_Sample_t ring[ACQ_RING];
+} Acq_t;
+
+unsigned char Acq_Init(Acq_t *a,const Acq_Config_t *cfg,uint8_t n);
+void Acq_Tick(Acq_t *a);
+void Acq_Alert(Acq_t *a);
+unsigned char Acq_BurstStart(Acq_t *a,uint8_t ch,Scope_t *scope);
+void Acq_BurstTick(Acq_t *a);
+void Acq_BurstStop(Acq_t *a);
+unsigned char Acq_Get(Acq_t *a,Acq_Sample_t *s);
+void Acq_I2cCallback(i2c_master_event_t event,void *param);
+
+#endif
@@ -0,0 +1,75 @@
+#include "Anim.h"
+
+/*
+	缓出三次曲线 1-(1-t)^3，t和返回值都是Q15，开始快结束慢
+	Q15的平方不超过2^30，M0+上只用32位乘法
+*/
+static int32_t Anim_Ease(int32_t t)
+{
+	int32_t u = (1 << ANIM_Q) - t;
+	u = (u * u) >> ANIM_Q;
+	u = (u * ((1 << ANIM_Q) - t)) >> ANIM_Q;
+	return (1 << ANIM_Q) - u;
+}
+
+void Anim_Init(Anim_t *a,int *value,uint16_t time)
+{
+	a->value = value;
+	a->from = *value;
+	a->to = *value;
+	a->start = 0;
+	a->time = time;
+	a->active = 0;
+}
+
+/*
+	从变量的当前值走向to，终点没变就什么都不做
+	动画走到一半换终点时从当前位置重新开始，不会跳
+*/
+void Anim_To(Anim_t *a,int to,uint32_t now)
+{
+	if(to == a->to && (a->active || *a->value == to))
+		return;
+	a->from = *a->value;
+	a->to = to;
+	a->start = now;
+	a->active = (a->from != to);
+}
+
+//直接跳到v，停止动画
+void Anim_Set(Anim_t *a,int v)
+{
+	*a->value = v;
+	a->from = v;
+	a->to = v;
+	a->active = 0;
+}
+
+//按当前时间算出变量的值，返回1表示还在动
+unsigned char Anim_Update(Anim_t *a,uint32_t now)
+{
+	uint32_t dt;
+	int32_t t;
+
+	if(!a->active)
+		return 0;
+	dt = now - a->start;
+	if(dt >= a->time)
+	{
+		*a->value = a->to;
+		a->active = 0;
+		return 0;
+	}
+	t = (int32_t)((dt << ANIM_Q) / a->time);
+	*a->value = a->from + (int)(((int32_t)(a->to - a->from) * Anim_Ease(t)) >> ANIM_Q);   //位移超过±65535会溢出，屏幕坐标够用
+	return 1;
+}
+
+//更新一组动画，返回还在动的个数，0表示全部停下，可以不再重画
+unsigned char Anim_UpdateList(Anim_t *list,unsigned char n,uint32_t now)
+{
+	unsigned char i,cnt = 0;
+	for(i=0;i<n;i++)
+		cnt += Anim_Update(&list[i],now);
+	return cnt;
+}
@@ -0,0 +1,34 @@
+#ifndef ANIM_H
+#define ANIM_H
+
+#include "main.h"
+
+/*
+	按时间走的缓动动画，菜单坐标不再每帧走固定像素
+	动画速度只和时间有关，主循环快慢(I2C、串口打印)不会让它变快变慢
+	每个Anim_t驱动一个int变量，可以同时跑很多个，放在数组里一起更新
+*/
+
+#define ANIM_Q      15       //缓动曲线的定点小数位数，进度 0~(1<<ANIM_Q)
+#define ANIM_TIME   180      //菜单移动默认时长 ms
+
+typedef struct
+{
+	int *value;              //被驱动的变量
+	int from;                //这一段的起点
+	int to;                  //这一段的终点
+	uint32_t start;          //这一段开始的时间 ms
+	uint16_t time;           //这一段的时长 ms
+	unsigned char active;    //1: 还没走到终点
+} Anim_t;
+
+//静态初始化: 变量已经在终点上，不动
+#define ANIM_INIT(p,v,t) {(p),(v),(v),0,(t),0}
+
+void Anim_Init(Anim_t *a,int *value,uint16_t time);
+void Anim_To(Anim_t *a,int to,uint32_t now);
+void Anim_Set(Anim_t *a,int v);
+unsigned char Anim_Update(Anim_t *a,uint32_t now);
+unsigned char Anim_UpdateList(Anim_t *list,unsigned char n,uint32_t now);
+
+#endif
@@ -31,7 +31,6 @@ Embodied in 3 functions related to I2C reading/writing
 */
 
 #include "Autofox_INA226_c.h"
-#include <math.h>
 
 
 
@@ -83,6 +82,9 @@ const int      cBusVoltConvTimeIdxShift     = 6;
 const int      cShuntVoltConvTimeIdxShift   = 3;
 const int      cMaxSampleAvgTblIdx          = 7;    //occupies 3 bit positions
 const int      cMaxConvTimeTblIdx           = 7; //occupies 3 bit positions
+//Tables from the INA226 spec, indexed by the AVG and VBUSCT/VSHCT fields of the configuration register
+static const uint16_t caNumSamplesAveraged[8]       = {1, 4, 16, 64, 128, 256, 512, 1024};
+static const uint16_t caVoltageConvTimeMicroSecs[8] = {140, 204, 332, 588, 1100, 2116, 4156, 8244};
 //=============================================================================
 
 void AutoFox_INA226_Constructor(AutoFox_INA226* this)
@@ -96,16 +98,19 @@ void AutoFox_INA226_Constructor(AutoFox_INA226* this)
 }
 
 //----------------------------------------------------------------------------
-status AutoFox_INA226_Init(AutoFox_INA226* this, uint8_t aI2C_Address, double aShuntResistor_Ohms, double aMaxCurrent_Amps)
+status AutoFox_INA226_Init(AutoFox_INA226* this, uint8_t aI2C_Address, uint32_t aShuntResistor_uOhms, int32_t aMaxCurrent_uA)
 {
 	uint16_t theINA226_ID;
 	this->mInitialized = false;
 
-	
+	//All register accesses go to this address, so set it before talking to the device
+	this->mI2C_Address = aI2C_Address;
 
-	//Good so far, check that it's an INA226 device at the specified address.
-	
-	AutoFox_INA226_ReadRegister(this,INA226_MANUFACTURER_ID, &theINA226_ID) ;
+	//Check that it's an INA226 device at the specified address.
+	//Nothing answering (NACK) is reported separately so a bus scan can tell "absent" from "wrong chip".
+	if(AutoFox_INA226_ReadRegister(this,INA226_MANUFACTURER_ID, &theINA226_ID) != OK){
+		return I2C_TRANSMISSION_ERROR;
+	}
 	if(theINA226_ID != INA226_MANUFACTURER_ID_K){
 		return INA226_TI_ID_MISMATCH; //Expected to find TI manufacturer ID
 	}
@@ -114,8 +119,6 @@ status AutoFox_INA226_Init(AutoFox_INA226* this, uint8_t aI2C_Address, double aS
 		return  INA226_DIE_ID_MISMATCH; //Expected to find INA226 device ID
 	}
 
-	this->mI2C_Address = aI2C_Address;
-
 	//Reset the INA226 device
 	AutoFox_INA226_WriteRegister(this,INA226_CONFIG, cResetCommand) ;
 
@@ -131,28 +134,41 @@ status AutoFox_INA226_Init(AutoFox_INA226* this, uint8_t aI2C_Address, double aS
 	//Finally, set up the calibration register - this will also calculate the scaling
 	//factors that we must apply to the current and power measurements that we read from
 	//the INA226 device.
-	AutoFox_INA226_setupCalibration(this, aShuntResistor_Ohms, aMaxCurrent_Amps) ;
+	if(AutoFox_INA226_setupCalibration(this, aShuntResistor_uOhms, aMaxCurrent_uA) != OK){
+		return BAD_PARAMETER;
+	}
 
 	this->mInitialized = true;
 	return OK;
 }
 //----------------------------------------------------------------------------
 
-status AutoFox_INA226_setupCalibration(AutoFox_INA226* this, double aShuntResistor_Ohms, double aMaxCurrent_Amps)
+status AutoFox_INA226_setupCalibration(AutoFox_INA226* this, uint32_t aShuntResistor_uOhms, int32_t aMaxCurrent_uA)
 {
 	// Calculate a value for Current_LSB that gives us the best resolution
 	// for current measurements.  The INA266 current register is 16-bit
 	// signed, max positive value is 2^15 -1 = 32767
-	// If we can be sure that the current won't be more than aMaxCurrent_Amps then
-	// we can calculate the Amps per bit as aMaxCurrent_Amps/32767 (rounded up to
+	// If we can be sure that the current won't be more than aMaxCurrent_uA then
+	// we can calculate the microamps per bit as aMaxCurrent_uA/32767 (rounded up to
 	// to the nearest integer).
 	// The value 0.00512 in the calculations below comes from the INA226 spec which
 	// provides a definition of the formula that's used to calculate the calibration value.
+	// With the shunt in micro-ohms and the LSB in microamps it becomes 5120000000/(uA*uOhm),
+	// done in integers (see INA226_CALIBRATION) so no soft-float code is linked.
 
-	double theCurrentLSB = ceil( ( aMaxCurrent_Amps * 1000000.0) / (double)32767.0);
-	double theCal = (double)0.00521 /  (aShuntResistor_Ohms * (theCurrentLSB/1000000.0));
+	int32_t theCurrentLSB;
+	uint32_t theCal;
+
+	if(aShuntResistor_uOhms == 0 || aMaxCurrent_uA <= 0){
+		return BAD_PARAMETER;
+	}
+	theCurrentLSB = INA226_CURRENT_LSB_UA(aMaxCurrent_uA);
+	theCal = INA226_CALIBRATION(aShuntResistor_uOhms, theCurrentLSB);
+	if(theCal == 0 || theCal > INA226_CALIBRATION_MAX){
+		return BAD_PARAMETER; //shunt and range don't fit the register, pick a larger/smaller range
+	}
 
-	this->mCurrentMicroAmpsPerBit = ((int32_t)theCurrentLSB);
+	this->mCurrentMicroAmpsPerBit = theCurrentLSB;
 	this->mCalibrationValue = (uint16_t)theCal;
 	this->mPowerMicroWattPerBit = this->mCurrentMicroAmpsPerBit * INA226_POWER_LSB_FACTOR;
 
@@ -188,8 +204,15 @@ status AutoFox_INA226_ReadRegister(AutoFox_INA226* this, uint8_t aRegister, uint
 {
 	*aValue_p = 0;
 	unsigned char dat[2]={0};
-	I2C_DRV_MasterSendDataBlocking(1,&aRegister,1,false,1000);
-	I2C_DRV_MasterReceiveDataBlocking(1, dat, 2, true, 1000);
+	//Several INA226s share the bus, so address this one explicitly instead of relying
+	//on whatever slave address the last transfer left behind
+	I2C_DRV_MasterSetSlaveAddr(INA226_I2C_INSTANCE, this->mI2C_Address, false);
+	if(I2C_DRV_MasterSendDataBlocking(INA226_I2C_INSTANCE,&aRegister,1,false,INA226_I2C_TIMEOUT) != STATUS_SUCCESS){
+		return I2C_TRANSMISSION_ERROR;
+	}
+	if(I2C_DRV_MasterReceiveDataBlocking(INA226_I2C_INSTANCE, dat, 2, true, INA226_I2C_TIMEOUT) != STATUS_SUCCESS){
+		return I2C_TRANSMISSION_ERROR;
+	}
 	*aValue_p = dat[0];
 	*aValue_p = *aValue_p<<8 | dat[1];
 	return OK;
@@ -203,7 +226,10 @@ status AutoFox_INA226_WriteRegister(AutoFox_INA226* this, uint8_t aRegister, uin
 	buffer[0] = aRegister;
 	buffer[1] = (uint8_t) ((aValue >> 8) & 0xFF);
 	buffer[2] = (uint8_t) (aValue & 0xFF);
-	I2C_DRV_MasterSendDataBlocking(1,buffer,3,false,1000);
+	I2C_DRV_MasterSetSlaveAddr(INA226_I2C_INSTANCE, this->mI2C_Address, false);
+	if(I2C_DRV_MasterSendDataBlocking(INA226_I2C_INSTANCE,buffer,3,true,INA226_I2C_TIMEOUT) != STATUS_SUCCESS){
+		return I2C_TRANSMISSION_ERROR;
+	}
 	return OK;
 }
 //----------------------------------------------------------------------------
@@ -246,6 +272,21 @@ int32_t AutoFox_INA226_GetPower_uW(AutoFox_INA226* this)
 	return theReturnValue;
 }
 //----------------------------------------------------------------------------
+void AutoFox_INA226_AddEnergy(int64_t* aEnergy_nJ_p, int32_t aPower_uW, uint32_t aInterval_ms)
+{
+	//uW * ms = nJ, a single 32x32->64 multiply per sample
+	*aEnergy_nJ_p += (int64_t)aPower_uW * aInterval_ms;
+}
+//----------------------------------------------------------------------------
+int32_t AutoFox_INA226_GetEnergy_uWh(int64_t aEnergy_nJ)
+{
+	//1 uWh = 3600000 nJ, round half away from zero
+	if(aEnergy_nJ < 0){
+		return -(int32_t)((-aEnergy_nJ + 1800000) / 3600000);
+	}
+	return (int32_t)((aEnergy_nJ + 1800000) / 3600000);
+}
+//----------------------------------------------------------------------------
 status AutoFox_INA226_Hibernate(AutoFox_INA226* this)
 {
 	CHECK_INITIALIZED();
@@ -410,6 +451,29 @@ status AutoFox_INA226_ConfigureNumSampleAveraging(AutoFox_INA226* this, int aInd
 	return AutoFox_INA226_WriteRegister(this,INA226_CONFIG, this->mConfigRegister);
 }
 //----------------------------------------------------------------------------
+uint32_t AutoFox_INA226_GetConversionPeriod_us(AutoFox_INA226* this)
+{
+	//Uses the local copy of the configuration register, no I2C traffic
+	uint16_t theConfig = this->mConfigRegister;
+	uint32_t theConvTime = 0;
+
+	if(theConfig & 0x0001){ //shunt voltage enabled
+		theConvTime += caVoltageConvTimeMicroSecs[(theConfig & cShuntVoltageConvTimeMask) >> cShuntVoltConvTimeIdxShift];
+	}
+	if(theConfig & 0x0002){ //bus voltage enabled
+		theConvTime += caVoltageConvTimeMicroSecs[(theConfig & cBusVoltageConvTimeMask) >> cBusVoltConvTimeIdxShift];
+	}
+	return theConvTime * caNumSamplesAveraged[(theConfig & cSampleAvgMask) >> cSampleAvgIdxShift];
+}
+//----------------------------------------------------------------------------
+status AutoFox_INA226_SetConfigRegister(AutoFox_INA226* this, uint16_t aConfigReg)
+{
+	CHECK_INITIALIZED();
+	//Never write the reset bit through here
+	this->mConfigRegister = aConfigReg & ~cResetCommand;
+	return AutoFox_INA226_WriteRegister(this,INA226_CONFIG, this->mConfigRegister);
+}
+//----------------------------------------------------------------------------
 status AutoFox_INA226_Debug_GetConfigRegister(AutoFox_INA226* this, uint16_t* aConfigReg_p)
 {
 	CHECK_INITIALIZED();
@@ -36,7 +36,7 @@
 
 #include <inttypes.h>
 #include <stdbool.h>
-#include "main.h"
+#include "sdk_project_config.h"
 
 
 //If building a project generated by CubeMX then the I2C handle will
@@ -53,6 +53,7 @@ struct INA226_HardCodedChipConst;
 struct INA226_DefaultSettings;
 
 static const int INA226_I2C_TIMEOUT = 1000;
+static const uint32_t INA226_I2C_INSTANCE = 1; //all INA226s sit on I2C1, each told apart by mI2C_Address
 
 //Most functions will return an error status
 typedef enum {OK=0, FAIL=-1,
@@ -73,6 +74,16 @@ typedef struct AutoFox_INA226{
     int32_t  mPowerMicroWattPerBit;
 } AutoFox_INA226;
 
+//=============================================================================
+//Fixed-point calibration.  Everything is integer so the Cortex-M0+ never pulls in
+//the soft-float library; with constant arguments both macros fold at compile time.
+//  Current_LSB = ceil(aMaxCurrent_uA / 32767)                     (uA per bit, rounded up so the range is never exceeded)
+//  CAL         = floor(0.00512 / (Current_LSB[A] * R_shunt[Ohm])) (= 5120000000 / (uA * uOhm), truncated like the register)
+#define INA226_CURRENT_LSB_UA(aMaxCurrent_uA)           (((int32_t)(aMaxCurrent_uA) + 32766) / 32767)
+#define INA226_CALIBRATION(aShunt_uOhms, aCurrentLSB_uA) \
+	((uint32_t)(5120000000ULL / ((uint64_t)(aCurrentLSB_uA) * (uint32_t)(aShunt_uOhms))))
+#define INA226_CALIBRATION_MAX                          0x7FFF //bit 15 of the register is reserved
+
 //=============================================================================
 
 enum eOperatingMode {//Shutdown=0,
@@ -105,14 +116,25 @@ void AutoFox_INA226_Constructor(AutoFox_INA226*);
 status AutoFox_INA226_CheckI2cAddress(uint8_t aI2C_Address);
 
 //Resets the INA226 and configures it according to the supplied parameters - should be called first.
-//status AutoFox_INA226_Init(uint8_t aI2C_Address=0x40, double aShuntResistor_Ohms=0.1, double aMaxCurrent_Amps=3.2767);
-status AutoFox_INA226_Init(AutoFox_INA226*,uint8_t aI2C_Address, double aShuntResistor_Ohms, double aMaxCurrent_Amps);
-
+//The shunt is given in micro-ohms and the range in microamps (e.g. 10000 for 0.01 Ohm, 5000000 for 5 A).
+//status AutoFox_INA226_Init(uint8_t aI2C_Address=0x40, uint32_t aShuntResistor_uOhms=100000, int32_t aMaxCurrent_uA=3276700);
+status AutoFox_INA226_Init(AutoFox_INA226*,uint8_t aI2C_Address, uint32_t aShuntResistor_uOhms, int32_t aMaxCurrent_uA);
+
+//Readings in scaled integers:
+//  shunt voltage: 2.5uV per bit, rounded down (towards minus infinity) to whole uV
+//  bus voltage:   1.25mV per bit, exact in uV
+//  current:       exact multiple of Current_LSB (mCurrentMicroAmpsPerBit)
+//  power:         exact multiple of 25 * Current_LSB (mPowerMicroWattPerBit)
 int32_t AutoFox_INA226_GetShuntVoltage_uV(AutoFox_INA226*);
 int32_t AutoFox_INA226_GetBusVoltage_uV(AutoFox_INA226*);
 int32_t AutoFox_INA226_GetCurrent_uA(AutoFox_INA226*);
 int32_t AutoFox_INA226_GetPower_uW(AutoFox_INA226*);
 
+//Energy is kept as a running sum of power * time in uW*ms (= nJ), 64 bits so it doesn't wrap
+//(2^63 nJ is ~2.5 GWh).  The uWh conversion rounds to nearest, halves away from zero.
+void    AutoFox_INA226_AddEnergy(int64_t* aEnergy_nJ_p, int32_t aPower_uW, uint32_t aInterval_ms);
+int32_t AutoFox_INA226_GetEnergy_uWh(int64_t aEnergy_nJ);
+
 status AutoFox_INA226_SetOperatingMode(AutoFox_INA226*,enum eOperatingMode aOpMode);
 status AutoFox_INA226_Hibernate(AutoFox_INA226*); //Enters a very low power mode, no voltage measurements
 status AutoFox_INA226_Wakeup(AutoFox_INA226*);    //Wake-up and enter the last operating mode
@@ -127,12 +149,16 @@ status AutoFox_INA226_ResetAlertPin(AutoFox_INA226*,enum  eAlertTriggerCause* aA
 status AutoFox_INA226_ConfigureVoltageConversionTime(AutoFox_INA226*,int aIndexToConversionTimeTable);
 status AutoFox_INA226_ConfigureNumSampleAveraging(AutoFox_INA226*,int aIndexToSampleAverageTable);
 status AutoFox_INA226_Debug_GetConfigRegister(AutoFox_INA226*,uint16_t* aConfigReg_p);
+//Writes a whole configuration register at once, e.g. to put back a copy taken from mConfigRegister
+status AutoFox_INA226_SetConfigRegister(AutoFox_INA226*,uint16_t aConfigReg);
+//Time between two new results in the current configuration: averages * (shunt + bus conversion time)
+uint32_t AutoFox_INA226_GetConversionPeriod_us(AutoFox_INA226*);
 
 //Private functions
 
 status AutoFox_INA226_WriteRegister(AutoFox_INA226*,uint8_t aRegister, uint16_t aValue);
 status AutoFox_INA226_ReadRegister(AutoFox_INA226*,uint8_t aRegister, uint16_t* aValue_p);
-status AutoFox_INA226_setupCalibration(AutoFox_INA226*,double aShuntResistor_Ohms, double aMaxCurrent_Amps);
+status AutoFox_INA226_setupCalibration(AutoFox_INA226*,uint32_t aShuntResistor_uOhms, int32_t aMaxCurrent_uA);
 
 
 
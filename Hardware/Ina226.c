@@ -1,6 +1,6 @@
 #include "Ina226.h"
 
-float Current_Now ;
+int32_t Current_Now;    //寄存器值*0.002，放大1000倍存成整数，不用软件浮点
 void INA226_Init(void)
 {
     I2C_DRV_MasterSetSlaveAddr(1,I2C_MasterConfig0.slaveAddress,I2C_MasterConfig0.is10bitAddr);
@@ -14,7 +14,7 @@ void INA226_Read2Byte(unsigned char reg_addr)
     I2C_DRV_MasterSetSlaveAddr(1,I2C_MasterConfig0.slaveAddress,I2C_MasterConfig0.is10bitAddr);
     I2C_DRV_MasterSendDataBlocking(1,dat,2,false,1000);
     I2C_DRV_MasterReceiveDataBlocking(1, dat, 2, true, 1000);
-    Current_Now = ((dat[0]<<8)|dat[1])*0.002;
+    Current_Now = (int32_t)((dat[0]<<8)|dat[1])*2;
 }
 
 void INA226_Write2Byte(unsigned char  reg_addr,unsigned short reg_data)
@@ -21,6 +21,6 @@ void INA226_Read2Byte(unsigned char reg_addr);
 void INA226_Write2Byte(unsigned char  reg_addr,unsigned short reg_data);
 void INA226_Init(void);
 
-extern float Current_Now;
+extern int32_t Current_Now;
 
 #endif
\ No newline at end of file
@@ -0,0 +1,355 @@
+#include "Menu.h"
+#include <string.h>
+
+#define MENU_ALL  ((1 << MENU_BUFS)-1)
+
+#define MENU_REDRAW_FULL    1    //字段整个清掉重画
+#define MENU_REDRAW_DIGITS  2    //只是值变了，只换变了的几位数字
+
+static int32_t Menu_Get(const Menu_Field_t *f)
+{
+	if(f->type == MENU_U8)
+		return *(unsigned char *)f->value;
+	return *(signed int *)f->value;
+}
+
+static void Menu_Set(const Menu_Field_t *f,int32_t v)
+{
+	v = v < f->min ? f->min : v;
+	v = v > f->max ? f->max : v;
+	if(f->type == MENU_U8)
+		*(unsigned char *)f->value = (unsigned char)v;
+	else
+		*(signed int *)f->value = (signed int)v;
+}
+
+//光标所在的字段，直接按行列算下标
+static const Menu_Field_t *Menu_Focus(Menu_t *m)
+{
+	const Menu_Form_t *fm = m->form;
+	return &fm->field[fm->sel0 + m->row*fm->cols + m->col];
+}
+
+//裁到屏幕里面，裁完是空的就x1=x0
+static void Menu_Clip(u8g2_t *u8g2,Menu_Rect_t *r)
+{
+	r->x0 = r->x0 < 0 ? 0 : r->x0;
+	r->y0 = r->y0 < 0 ? 0 : r->y0;
+	r->x1 = r->x1 > u8g2_GetDisplayWidth(u8g2) ? u8g2_GetDisplayWidth(u8g2) : r->x1;
+	r->y1 = r->y1 > u8g2_GetDisplayHeight(u8g2) ? u8g2_GetDisplayHeight(u8g2) : r->y1;
+	if(r->x1 <= r->x0 || r->y1 <= r->y0)
+		r->x1 = r->x0;
+}
+
+static unsigned char Menu_Overlap(const Menu_Rect_t *a,const Menu_Rect_t *b)
+{
+	return a->x0 < b->x1 && b->x0 < a->x1 && a->y0 < b->y1 && b->y0 < a->y1;
+}
+
+//字段的文字框: 标签的宽度按表，数值按位数，高度是整个字体的字框(包括下沿)，光标对着它画
+static void Menu_FieldBox(Menu_t *m,u8g2_t *u8g2,const Menu_Field_t *f,Menu_Rect_t *r)
+{
+	r->x0 = f->x - ((f->flags & MENU_F_SCROLL) ? m->sx : 0);
+	r->y0 = f->y - (u8g2->font_info.max_char_height + u8g2->font_info.y_offset);
+	r->x1 = r->x0 + (f->type == MENU_LABEL ? f->w : f->digits*m->dw);
+	r->y1 = r->y0 + u8g2->font_info.max_char_height;
+}
+
+//重画字段时要清的地方: 文字框加上字框伸出去的部分(左边的x偏移，右边比字宽多出来的)，裁到屏幕里
+static void Menu_FieldRect(Menu_t *m,u8g2_t *u8g2,const Menu_Field_t *f,Menu_Rect_t *r)
+{
+	int16_t pad = u8g2->font_info.max_char_width + u8g2->font_info.x_offset - m->dw;
+	Menu_FieldBox(m,u8g2,f,r);
+	if(u8g2->font_info.x_offset < 0)
+		r->x0 += u8g2->font_info.x_offset;
+	if(pad > 0)
+		r->x1 += pad;
+	Menu_Clip(u8g2,r);
+}
+
+static void Menu_Clear(u8g2_t *u8g2,const Menu_Rect_t *r)
+{
+	if(r->x1 > r->x0)
+		u8g2_ClearBufferArea(u8g2,r->x0,r->y0,r->x1-r->x0,r->y1-r->y0);
+}
+
+/*
+	shown是这个字段在这块缓冲上画的值，画完换成新值
+	digits为1时缓冲里还是shown的数字，只清掉重画不一样的几位；为0时字段已经清过(或者只是补画)，所有位都画
+*/
+static void Menu_DrawField(Menu_t *m,u8g2_t *u8g2,const Menu_Field_t *f,int32_t *shown,unsigned char digits)
+{
+	int16_t x = f->x - ((f->flags & MENU_F_SCROLL) ? m->sx : 0);
+	Menu_Rect_t r;
+	int32_t v;
+	Menu_FieldRect(m,u8g2,f,&r);
+	if(r.x1 == r.x0)                  //整个在屏幕外面
+		return;
+	if(f->type == MENU_LABEL)
+	{
+		u8g2_DrawUTF8Cached(u8g2,(u8g2_text_cache_t *)f->value,x,f->y,f->str);
+		return;
+	}
+	v = Menu_Get(f);
+	u8g2_DrawNumberDigits(u8g2,m->digit,x,f->y,v,digits ? shown : NULL,f->digits,0);
+	*shown = v;
+}
+
+/*
+	光标的样子跟着(cx,cy)走，w h是选中字段的大小
+	编辑时是圆角框，选择时按界面设置画三角或者横线
+*/
+static void Menu_CursorRect(Menu_t *m,u8g2_t *u8g2,int16_t w,int16_t h,Menu_Rect_t *r)
+{
+	if(m->editing)
+	{
+		r->x0 = m->cx-3;
+		r->y0 = m->cy-1;
+		r->x1 = r->x0+w+6;
+		r->y1 = r->y0+h+2;
+	}
+	else if(m->form->cursor == MENU_CURSOR_ARROW)
+	{
+		r->x0 = m->cx-6;
+		r->y0 = m->cy+h/2-4;
+		r->x1 = r->x0+5;
+		r->y1 = r->y0+9;
+	}
+	else
+	{
+		r->x0 = m->cx;
+		r->y0 = m->cy+h-1;
+		r->x1 = r->x0+w;
+		r->y1 = r->y0+1;
+	}
+	Menu_Clip(u8g2,r);
+}
+
+static void Menu_DrawCursor(Menu_t *m,u8g2_t *u8g2,const Menu_Rect_t *r)
+{
+	u8g2_uint_t w = r->x1-r->x0,h = r->y1-r->y0;
+	if(w == 0)
+		return;
+	if(m->editing)
+		u8g2_DrawRFrame(u8g2,r->x0,r->y0,w,h,w > 6 && h > 6 ? 2 : 0);
+	else if(m->form->cursor == MENU_CURSOR_ARROW)
+		u8g2_DrawTriangle(u8g2,r->x0,r->y0,r->x0,r->y0+8,r->x0+4,r->y0+4);
+	else
+		u8g2_DrawHLine(u8g2,r->x0,r->y0,w);
+}
+
+//选中的字段在屏幕外面时把会滚动的字段整体挪过来，挪了就整屏重画
+static void Menu_Scroll(Menu_t *m,u8g2_t *u8g2)
+{
+	const Menu_Field_t *f = Menu_Focus(m);
+	int16_t sx = m->sx;
+	Menu_Rect_t r;
+	if((f->flags & MENU_F_SCROLL) == 0)
+		return;
+	Menu_FieldBox(m,u8g2,f,&r);
+	if(r.x0 < 0)
+		sx += r.x0;
+	if(r.x1 > u8g2_GetDisplayWidth(u8g2))
+		sx += r.x1 - u8g2_GetDisplayWidth(u8g2);
+	if(sx != m->sx)
+	{
+		m->sx = sx;
+		m->full = MENU_ALL;
+	}
+}
+
+void Menu_Init(Menu_t *m,u8g2_digit_cache_t *digit)
+{
+	memset(m,0,sizeof(*m));
+	m->digit = digit;
+	Anim_Init(&m->anim[0],&m->cx,ANIM_TIME);
+	Anim_Init(&m->anim[1],&m->cy,ANIM_TIME);
+}
+
+//换界面，光标回到第一个字段，从左上角滑过去；两块缓冲都要整屏重画
+void Menu_Enter(Menu_t *m,const Menu_Form_t *form)
+{
+	m->form = form;
+	m->col = 0;
+	m->row = 0;
+	m->editing = 0;
+	m->sx = 0;
+	Anim_Set(&m->anim[0],0);
+	Anim_Set(&m->anim[1],0);
+	Menu_Invalidate(m);
+}
+
+//帧缓冲被别人画过(比如弹窗)以后调用，下一帧整屏重画
+void Menu_Invalidate(Menu_t *m)
+{
+	m->full = MENU_ALL;
+}
+
+/*
+	处理按键，左右和主菜单一样是反的(左键往右走)
+	选择时方向键移光标，OK进入编辑；编辑时按界面设置用摇杆或上下键加减，OK退出编辑
+	返回MENU_BACK表示按了返回键
+*/
+unsigned char Menu_Input(Menu_t *m)
+{
+	const Menu_Form_t *fm = m->form;
+	const Menu_Field_t *f = Menu_Focus(m);
+	int32_t d = 0;
+
+	if(GetLOk)
+	{
+		ClrLOk;
+		m->editing = 0;
+		return MENU_BACK;
+	}
+	if(m->editing)
+	{
+		if(fm->edit == MENU_EDIT_AIN)
+		{
+			d = AINX > 2500 ? 1 : AINX < 1500 ? -1 : 0;
+			ClrUp;                      //摇杆偏着时Potenmeter也会置上下键，不能留到退出编辑以后去移光标
+			ClrDown;
+		}
+		else
+		{
+			if(GetUp)
+			{
+				ClrUp;
+				d = 1;
+			}
+			if(GetDown)
+			{
+				ClrDown;
+				d = -1;
+			}
+		}
+		ClrLeft;
+		ClrRight;
+		if(d != 0)
+			Menu_Set(f,Menu_Get(f)+d);
+		if(GetOk)
+		{
+			ClrOk;
+			m->editing = 0;
+		}
+		return MENU_IDLE;
+	}
+	if(GetLeft)
+	{
+		ClrLeft;
+		if(m->col+1 < fm->cols)
+			m->col++;
+	}
+	if(GetRight)
+	{
+		ClrRight;
+		if(m->col > 0)
+			m->col--;
+	}
+	if(GetUp)
+	{
+		ClrUp;
+		if(m->row > 0)
+			m->row--;
+	}
+	if(GetDown)
+	{
+		ClrDown;
+		if(m->row+1 < fm->rows)
+			m->row++;
+	}
+	if(GetOk)
+	{
+		ClrOk;
+		m->editing = 1;
+	}
+	return MENU_IDLE;
+}
+
+/*
+	把界面画到u8g2当前的帧缓冲里，buf是这块缓冲的编号(0或1)
+	缓冲里是这块缓冲上次画完的样子，只清掉并重画:
+	  要整个重画的字段、光标离开的地方，以及和清掉的地方重叠的字段
+	  只是值变了的数值字段只换变了的几位
+	光标动画还没走完时返回1
+*/
+unsigned char Menu_Draw(Menu_t *m,u8g2_t *u8g2,uint8_t buf,uint32_t now)
+{
+	const Menu_Form_t *fm = m->form;
+	uint8_t bit = 1 << buf;
+	uint8_t redraw[MENU_FIELD_MAX];
+	Menu_Rect_t r,rk,oc,nc;
+	unsigned char anim,moved,hit = 0,clean = 0;
+	uint8_t i,k;
+
+	if(m->full)
+		m->dw = u8g2_GetGlyphWidth(u8g2,'0');   //数值字段的宽度按字体的数字宽度算
+	Menu_Scroll(m,u8g2);
+	if(m->full & bit)
+	{
+		m->full &= ~bit;
+		u8g2_ClearDrawnArea(u8g2);
+		clean = 1;                    //整块已经清过，下面不用再一个个清字段
+		for(i=0;i<fm->num;i++)
+			m->dirty[i] |= bit;
+		m->cur[buf].x1 = m->cur[buf].x0;
+	}
+
+	Menu_FieldBox(m,u8g2,Menu_Focus(m),&r);
+	Anim_To(&m->anim[0],r.x0,now);
+	Anim_To(&m->anim[1],r.y0,now);
+	anim = Anim_UpdateList(m->anim,2,now);
+	Menu_CursorRect(m,u8g2,r.x1-r.x0,r.y1-r.y0,&nc);
+	oc = m->cur[buf];
+	moved = oc.x0 != nc.x0 || oc.y0 != nc.y0 || oc.x1 != nc.x1 || oc.y1 != nc.y1;
+
+	if(moved && !clean)
+		Menu_Clear(u8g2,&oc);
+	for(i=0;i<fm->num;i++)
+	{
+		Menu_FieldRect(m,u8g2,&fm->field[i],&r);
+		redraw[i] = 0;
+		if((m->dirty[i] & bit) || (moved && Menu_Overlap(&r,&oc)))
+		{
+			redraw[i] = MENU_REDRAW_FULL;
+			if(!clean)
+				Menu_Clear(u8g2,&r);
+		}
+		else if(fm->field[i].type != MENU_LABEL && Menu_Get(&fm->field[i]) != m->shown[buf][i])
+			redraw[i] = MENU_REDRAW_DIGITS;   //绑定的变量在别处改了(LIN收到数据)也能发现
+	}
+	for(i=0;i<fm->num;i++)            //只换几位的字段自己清自己画，要在整个重画和补画之前
+	{
+		if(redraw[i] != MENU_REDRAW_DIGITS)
+			continue;
+		Menu_FieldRect(m,u8g2,&fm->field[i],&r);
+		if(Menu_Overlap(&r,&nc))
+			hit = 1;
+		Menu_DrawField(m,u8g2,&fm->field[i],&m->shown[buf][i],1);
+	}
+	for(i=0;i<fm->num;i++)
+	{
+		Menu_FieldRect(m,u8g2,&fm->field[i],&r);
+		if(redraw[i] != MENU_REDRAW_FULL)   //字框会和相邻的字段重叠一点，被别人清掉一部分的也要补画
+		{
+			for(k=0;k<fm->num;k++)
+			{
+				if(!redraw[k] || k == i)
+					continue;
+				Menu_FieldRect(m,u8g2,&fm->field[k],&rk);
+				if(Menu_Overlap(&r,&rk))
+					break;
+			}
+			if(k == fm->num)
+				continue;
+		}
+		else if(Menu_Overlap(&r,&nc))
+			hit = 1;
+		Menu_DrawField(m,u8g2,&fm->field[i],&m->shown[buf][i],0);
+		m->dirty[i] &= ~bit;
+	}
+	if(moved || hit)
+		Menu_DrawCursor(m,u8g2,&nc);
+	m->cur[buf] = nc;
+	return anim;
+}
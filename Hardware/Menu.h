@@ -0,0 +1,91 @@
+#ifndef MENU_H
+#define MENU_H
+
+#include "main.h"
+#include "Anim.h"
+
+/*
+	表格驱动的菜单界面
+	一个界面(Menu_Form_t)是一张字段表，数值字段直接绑定到要显示/修改的变量上，
+	光标按(列,行)走，选中的字段是 sel0+行*cols+列，不用从像素坐标反算
+	画面是保留的: 帧缓冲里的内容不整屏清，每帧只重画值变了的字段和光标盖到的字段，
+	两块帧缓冲轮流用，每个字段记着哪块缓冲上还是旧的，以及每块缓冲上画的是哪个值
+	只是值变了的数值字段只换变了的那几位数字，数字从digit缓存里拷贝
+*/
+
+#define MENU_FIELD_MAX  40       //一个界面最多的字段数
+#define MENU_BUFS       2        //帧缓冲块数，和OLED_FrameBuf一样
+
+#define MENU_LABEL  0            //不变的文字，value是它的文字缓存
+#define MENU_INT    1            //signed int变量
+#define MENU_U8     2            //unsigned char变量
+
+#define MENU_F_SCROLL  0x01      //一行放不下时跟着光标左右滚动
+
+#define MENU_CURSOR_ARROW  0     //选择时字段左边一个小三角
+#define MENU_CURSOR_LINE   1     //选择时字段下面一条横线
+
+#define MENU_EDIT_AIN  0         //编辑时摇杆偏着就每帧加减1，适合范围大的数
+#define MENU_EDIT_KEY  1         //编辑时上下键一次加减1
+
+#define MENU_IDLE  0             //Menu_Input的返回值
+#define MENU_BACK  1             //按了返回键，由调用者换界面
+
+typedef struct
+{
+	uint8_t type;                //MENU_LABEL / MENU_INT / MENU_U8
+	uint8_t flags;               //MENU_F_xxx
+	int16_t x;                   //文字左下角(基线)，滚动的字段是没滚动时的位置
+	int16_t y;
+	uint8_t w;                   //标签的宽度，数值按位数和字体算，高度都按字体算
+	uint8_t digits;              //数值右对齐的位数
+	void *value;                 //绑定的变量
+	const char *str;             //标签文字
+	int16_t min;                 //数值范围
+	int16_t max;
+} Menu_Field_t;
+
+#define MENU_LABEL_FIELD(x,y,w,tc,s)      {MENU_LABEL,0,(x),(y),(w),0,(tc),(s),0,0}
+#define MENU_INT_FIELD(x,y,n,p,lo,hi,f)   {MENU_INT,(f),(x),(y),0,(n),(p),NULL,(lo),(hi)}
+#define MENU_U8_FIELD(x,y,n,p,lo,hi,f)    {MENU_U8,(f),(x),(y),0,(n),(p),NULL,(lo),(hi)}
+
+typedef struct
+{
+	const Menu_Field_t *field;
+	uint8_t num;                 //字段数
+	uint8_t sel0;                //第一个能选的字段，能选的字段按行排在表的最后
+	uint8_t cols;
+	uint8_t rows;
+	uint8_t cursor;              //MENU_CURSOR_xxx
+	uint8_t edit;                //MENU_EDIT_xxx
+} Menu_Form_t;
+
+typedef struct
+{
+	int16_t x0,y0,x1,y1;         //x1 y1不含
+} Menu_Rect_t;
+
+typedef struct
+{
+	const Menu_Form_t *form;     //当前界面
+	uint8_t col;                 //光标
+	uint8_t row;
+	uint8_t editing;             //1: 正在改光标所在的值
+	uint8_t full;                //还要整屏重画的缓冲，一位一块
+	uint8_t dirty[MENU_FIELD_MAX];   //字段在哪几块缓冲上要整个清掉重画
+	int32_t shown[MENU_BUFS][MENU_FIELD_MAX];   //数值字段在每块缓冲上画的值
+	u8g2_digit_cache_t *digit;   //数值字段用的数字缓存
+	int16_t sx;                  //滚动的字段往左移了多少
+	uint8_t dw;                  //数字的宽度
+	int cx,cy;                   //光标所在字段的左上角，动画驱动
+	Anim_t anim[2];
+	Menu_Rect_t cur[MENU_BUFS];  //每块缓冲上光标画在哪
+} Menu_t;
+
+void Menu_Init(Menu_t *m,u8g2_digit_cache_t *digit);
+void Menu_Enter(Menu_t *m,const Menu_Form_t *form);
+void Menu_Invalidate(Menu_t *m);
+unsigned char Menu_Input(Menu_t *m);
+unsigned char Menu_Draw(Menu_t *m,u8g2_t *u8g2,uint8_t buf,uint32_t now);
+
+#endif
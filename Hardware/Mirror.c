@@ -0,0 +1,120 @@
+#include "Mirror.h"
+#include <string.h>
+
+#define MIRROR_DIRTY(m,t)  ((m)->dirty[(t)>>3] & (1<<((t)&7)))
+
+void Mirror_Init(Mirror_t *m)
+{
+	m->seq = 0;
+	Mirror_Invalidate(m);
+}
+
+//下一包开始整屏重发
+void Mirror_Invalidate(Mirror_t *m)
+{
+	memset(m->dirty,0xFF,sizeof(m->dirty));
+	m->start_line = 0xFF;
+}
+
+/*
+	frame是要发给屏的这一帧，prev是屏上现在的内容(影子缓冲)，不一样的tile记下来
+	prev为NULL时全部记下；串口忙的时候也要调用，攒着的tile等空闲时一起发
+*/
+void Mirror_Mark(Mirror_t *m,const uint8_t *frame,const uint8_t *prev)
+{
+	uint8_t t;
+
+	if(prev == NULL)
+	{
+		memset(m->dirty,0xFF,sizeof(m->dirty));
+		return;
+	}
+	for(t=0;t<MIRROR_TILES;t++)
+		if(memcmp(frame+t*8,prev+t*8,8) != 0)
+			m->dirty[t>>3] |= 1<<(t&7);
+}
+
+/*
+	游程压缩，重复3个以上的字节才算一段重复，这样最坏只比原数据多 len/128+1 字节
+*/
+static uint16_t Mirror_Rle(uint8_t *out,const uint8_t *in,uint16_t len)
+{
+	uint8_t *o = out;
+	uint16_t i = 0,run,lit;
+
+	while(i < len)
+	{
+		run = 1;
+		while(i+run < len && run < 130 && in[i+run] == in[i])
+			run++;
+		if(run >= 3)
+		{
+			*o++ = 0x80+run-3;
+			*o++ = in[i];
+			i += run;
+			continue;
+		}
+		lit = run;                   //原样段一直到下一个至少3个一样的字节为止
+		while(i+lit < len && lit < 128 &&
+			!(i+lit+2 < len && in[i+lit] == in[i+lit+1] && in[i+lit] == in[i+lit+2]))
+			lit++;
+		*o++ = lit-1;
+		memcpy(o,in+i,lit);
+		o += lit;
+		i += lit;
+	}
+	return o-out;
+}
+
+/*
+	把还没发的tile从screen(屏上现在的内容)里取出来打成一包，放不下的留到下一包
+	返回包长度，没有要发的返回0
+*/
+uint16_t Mirror_Encode(Mirror_t *m,const uint8_t *screen,uint8_t start_line)
+{
+	uint8_t *p = m->buf+4;
+	uint8_t *end = m->buf+MIRROR_TX_SIZE-1;   //最后1字节是校验
+	uint16_t t,n,i,len;
+	uint8_t sum = 0;
+
+	for(i=0;i<sizeof(m->dirty);i++)
+		if(m->dirty[i])
+			break;
+	if(i == sizeof(m->dirty) && start_line == m->start_line)
+		return 0;
+
+	*p++ = m->seq++;
+	*p++ = start_line;
+	m->start_line = start_line;
+	t = 0;
+	while(t < MIRROR_TILES)
+	{
+		if(!MIRROR_DIRTY(m,t))
+		{
+			t++;
+			continue;
+		}
+		for(n=1;t+n < MIRROR_TILES && MIRROR_DIRTY(m,t+n);n++)
+			;
+		while(n > 0 && 2+n*8+(n*8+127)/128 > end-p)   //按最坏的压缩结果算放得下几个
+			n--;
+		if(n == 0)
+			break;
+		*p++ = t;
+		*p++ = n;
+		p += Mirror_Rle(p,screen+t*8,n*8);
+		for(i=t;i<t+n;i++)
+			m->dirty[i>>3] &= ~(1<<(i&7));
+		t += n;
+	}
+
+	len = p-(m->buf+4);
+	m->buf[0] = 0xA5;
+	m->buf[1] = 0x5A;
+	m->buf[2] = len&0xFF;
+	m->buf[3] = len>>8;
+	for(i=0;i<len;i++)
+		sum += m->buf[4+i];
+	*p++ = ~sum;
+	return p-m->buf;
+}
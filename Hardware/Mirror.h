@@ -0,0 +1,33 @@
+#ifndef MIRROR_H
+#define MIRROR_H
+
+#include <stdint.h>
+
+/*
+	屏幕镜像: 只把变了的8x8 tile游程压缩后从串口发出去，PC上用 tools/mirror.py 看
+	包格式:
+		A5 5A  负载长度L(2字节 低字节在前)  负载L字节  校验(负载各字节的和取反 1字节)
+		负载: 包序号(1) 显示起始行(1)，后面若干段 [第一个tile号(1) tile数n(1) n*8字节显存的RLE]
+		tile号 = 页*16 + 列/8，一段里的tile在显存里是连着的
+		RLE: 控制字节c<0x80 后面跟c+1个原样字节；c>=0x80 后面1个字节重复c-0x80+3次
+*/
+#define MIRROR_TILES    128      //16列x8页
+#define MIRROR_TX_SIZE  384      //一包最多的字节数，115200波特率约33ms，放不下的tile留到下一包
+#define MIRROR_REFRESH  5000     //ms，隔这么久整屏重发一遍，丢了包或者中途打开查看器也能恢复
+#define MIRROR_PERIOD   100      //ms，两包之间至少隔这么久，中间变了的tile合到下一包；
+                                 //满包384字节每秒10包约占115200波特率的1/3，剩下的留给PRINTF
+
+typedef struct
+{
+	uint8_t dirty[MIRROR_TILES/8];   //还没发出去的tile
+	uint8_t start_line;              //上一包的显示起始行，0xFF: 还没发过
+	uint8_t seq;                     //包序号，查看器用来发现丢包
+	uint8_t buf[MIRROR_TX_SIZE];     //正在发送的包，发完之前不能改
+}Mirror_t;
+
+void Mirror_Init(Mirror_t *m);
+void Mirror_Invalidate(Mirror_t *m);
+void Mirror_Mark(Mirror_t *m,const uint8_t *frame,const uint8_t *prev);
+uint16_t Mirror_Encode(Mirror_t *m,const uint8_t *screen,uint8_t start_line);
+
+#endif
@@ -0,0 +1,146 @@
+#include "Plot.h"
+#include <string.h>
+
+//数值对应的行，hi在第0行，lo在第PLOT_HEIGHT-1行
+static uint8_t Plot_Row(Plot_t *p,int32_t v)
+{
+	uint32_t d,s;
+	if(v >= p->hi)
+		return 0;
+	if(v <= p->lo)
+		return PLOT_HEIGHT-1;
+	d = (uint32_t)(p->hi - v);
+	s = (uint32_t)(p->hi - p->lo);
+	while(s > 0xFFFFFFFFu/(PLOT_HEIGHT-1))   //量程太大时先一起缩小，乘法不溢出
+	{
+		d >>= 1;
+		s >>= 1;
+	}
+	return (uint8_t)(d*(PLOT_HEIGHT-1)/s);
+}
+
+/*
+	把环形里第i列画到图上第x列，整列重写
+	和前一列不重叠时往前一列那边延长，线是连着的
+*/
+static void Plot_Column(Plot_t *p,uint8_t x,uint8_t i,unsigned char link)
+{
+	int32_t top = p->max[i],bot = p->min[i];
+	uint8_t r0,r1,pg,b0,b1;
+	if(link)
+	{
+		uint8_t prev = i == 0 ? PLOT_WIDTH-1 : i-1;
+		if(p->max[prev] < bot)
+			bot = p->max[prev];
+		if(p->min[prev] > top)
+			top = p->min[prev];
+	}
+	r0 = Plot_Row(p,top);
+	r1 = Plot_Row(p,bot);
+	for(pg=0;pg<PLOT_PAGES;pg++)
+	{
+		b0 = pg*8;
+		b1 = b0+7;
+		if(r1 < b0 || r0 > b1)
+		{
+			p->bmp[pg][x] = 0;
+			continue;
+		}
+		b0 = r0 > b0 ? r0-b0 : 0;
+		b1 = r1 < b1 ? r1-pg*8 : 7;
+		p->bmp[pg][x] = (uint8_t)((0xFF >> (7-(b1-b0))) << b0);
+	}
+}
+
+//按当前量程整张重画
+static void Plot_Render(Plot_t *p)
+{
+	uint8_t x,i,n;
+	memset(p->bmp,0,sizeof(p->bmp));
+	i = p->head;
+	for(n=0;n<p->cnt;n++)           //从最新的一列往左画
+	{
+		i = i == 0 ? PLOT_WIDTH-1 : i-1;
+		x = PLOT_WIDTH-1-n;
+		Plot_Column(p,x,i,n+1 < p->cnt);
+	}
+}
+
+/*
+	看得见的列超出量程，或者只用到不到一半量程时重新定范围，上下各留1/8
+	返回1: 量程变了，要整张重画
+*/
+static unsigned char Plot_Rescale(Plot_t *p)
+{
+	int32_t lo,hi,margin;
+	uint8_t i,n;
+	i = p->head;
+	lo = hi = p->min[i == 0 ? PLOT_WIDTH-1 : i-1];
+	for(n=0;n<p->cnt;n++)
+	{
+		i = i == 0 ? PLOT_WIDTH-1 : i-1;
+		if(p->min[i] < lo)
+			lo = p->min[i];
+		if(p->max[i] > hi)
+			hi = p->max[i];
+	}
+	if(hi-lo < PLOT_MIN_SPAN)
+	{
+		lo = lo+(hi-lo)/2-PLOT_MIN_SPAN/2;
+		hi = lo+PLOT_MIN_SPAN;
+	}
+	if(lo >= p->lo && hi <= p->hi && (hi-lo)*2 >= p->hi-p->lo)
+		return 0;
+	margin = (hi-lo)/8;
+	p->lo = lo-margin;
+	p->hi = hi+margin;
+	return 1;
+}
+
+/*
+	per_col: 几个样本合成一列，5Hz采样、1个样本一列时整张图是PLOT_WIDTH/5秒
+*/
+void Plot_Init(Plot_t *p,uint8_t per_col)
+{
+	memset(p,0,sizeof(*p));
+	p->per_col = per_col == 0 ? 1 : per_col;
+}
+
+/*
+	加一个样本，攒够per_col个出一列
+	返回1: 图变了，要重画屏幕  0: 这一列还没攒满
+*/
+unsigned char Plot_Add(Plot_t *p,int32_t v)
+{
+	uint8_t i,pg;
+	if(p->acc_n == 0 || v < p->acc_min)
+		p->acc_min = v;
+	if(p->acc_n == 0 || v > p->acc_max)
+		p->acc_max = v;
+	if(++p->acc_n < p->per_col)
+		return 0;
+	p->acc_n = 0;
+
+	i = p->head;
+	p->min[i] = p->acc_min;
+	p->max[i] = p->acc_max;
+	p->head = i+1 == PLOT_WIDTH ? 0 : i+1;
+	if(p->cnt < PLOT_WIDTH)
+		p->cnt++;
+
+	if(Plot_Rescale(p))
+	{
+		Plot_Render(p);
+		return 1;
+	}
+	for(pg=0;pg<PLOT_PAGES;pg++)    //整张图左移一列，只画新的一列
+		memmove(p->bmp[pg],p->bmp[pg]+1,PLOT_WIDTH-1);
+	Plot_Column(p,PLOT_WIDTH-1,i,p->cnt > 1);
+	return 1;
+}
+
+//y按8对齐(页边界)时u8g2_DrawTileBitmap整字节拷贝，最快
+void Plot_Draw(Plot_t *p,u8g2_t *u8g2,u8g2_uint_t x,u8g2_uint_t y)
+{
+	u8g2_DrawTileBitmap(u8g2,x,y,PLOT_WIDTH,PLOT_HEIGHT,&p->bmp[0][0]);
+}
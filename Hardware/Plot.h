@@ -0,0 +1,37 @@
+#ifndef PLOT_H
+#define PLOT_H
+
+#include "u8g2.h"
+
+/*
+	电流滚动曲线(示波器那样从右往左走)
+	每列一个像素，画这一列时间里样本的最小值到最大值(包络)，和前一列连起来
+	图像按tile格式留在bmp里，新来一列时整张图左移一列、只画新的一列，
+	量程要变的时候才整张重画，显示时用u8g2_DrawTileBitmap拷进帧缓冲
+*/
+
+#define PLOT_WIDTH     88     //列数(像素)
+#define PLOT_PAGES     6      //高度，按页算(8行一页)，和显存一样竖排
+#define PLOT_HEIGHT    (PLOT_PAGES*8)
+#define PLOT_MIN_SPAN  1000   //纵轴最小量程，和样本同单位(uA)，电流几乎不变时不会把噪声放大满屏
+
+typedef struct
+{
+	int32_t min[PLOT_WIDTH];         //每列的最小值，环形，head是下一个要写的列
+	int32_t max[PLOT_WIDTH];         //每列的最大值
+	uint8_t head;
+	uint8_t cnt;                     //已经有的列数，不超过PLOT_WIDTH
+	uint8_t per_col;                 //几个样本合成一列
+	uint8_t acc_n;                   //当前列已经收到的样本数
+	int32_t acc_min;                 //当前列还没画出来的最小/最大值
+	int32_t acc_max;
+	int32_t lo;                      //纵轴范围，lo在最下面一行，hi在最上面一行
+	int32_t hi;
+	uint8_t bmp[PLOT_PAGES][PLOT_WIDTH];  //tile格式的图，最右一列是最新的
+} Plot_t;
+
+void Plot_Init(Plot_t *p,uint8_t per_col);
+unsigned char Plot_Add(Plot_t *p,int32_t v);
+void Plot_Draw(Plot_t *p,u8g2_t *u8g2,u8g2_uint_t x,u8g2_uint_t y);
+
+#endif
@@ -0,0 +1,148 @@
+#include "Scope.h"
+#include "main.h"
+
+#define SCOPE_MASK  (SCOPE_DEPTH-1)
+
+/*
+	界面调用: 设好触发条件，等主循环开始突发读
+	pre+post超过SCOPE_DEPTH时先减pre，post至少1个(触发那个)
+*/
+void Scope_Arm(Scope_t *s,uint8_t mode,int32_t lo_ua,int32_t hi_ua,uint16_t pre,uint16_t post)
+{
+	if(post == 0)
+		post = 1;
+	if(post > SCOPE_DEPTH)
+		post = SCOPE_DEPTH;
+	if(pre > SCOPE_DEPTH-post)
+		pre = SCOPE_DEPTH-post;
+	s->mode = mode;
+	s->lo_ua = lo_ua;
+	s->hi_ua = hi_ua;
+	s->pre = pre;
+	s->post = post;
+	s->state = SCOPE_ARM;
+}
+
+//uA换成寄存器值，四舍五入到一个LSB，超出int16就取边上
+static int16_t Scope_Raw(int32_t ua,int32_t lsb)
+{
+	int32_t r = ua >= 0 ? (ua + lsb/2) / lsb : -((-ua + lsb/2) / lsb);
+	return r > 32767 ? 32767 : r < -32768 ? -32768 : (int16_t)r;
+}
+
+/*
+	采集把INA226切到最快以后调用，阈值按这个芯片的LSB换成寄存器值，中断里只比较int16
+	之后样本由Scope_Add送进来
+*/
+void Scope_Start(Scope_t *s,int32_t lsb,uint16_t period_us)
+{
+	s->lsb = lsb;
+	s->period_us = period_us;
+	s->lo = Scope_Raw(s->lo_ua,lsb);
+	s->hi = Scope_Raw(s->hi_ua,lsb);
+	s->head = 0;
+	s->fill = 0;                      //fill: 当前样本前面已经有几个，到pre(至少1)为止
+	s->state = SCOPE_PRE;
+}
+
+static unsigned char Scope_Trigger(Scope_t *s,int16_t raw)
+{
+	switch(s->mode)
+	{
+	case SCOPE_LEVEL:
+		return raw >= s->hi;
+	case SCOPE_RISE:
+		return s->last < s->hi && raw >= s->hi;
+	case SCOPE_FALL:
+		return s->last > s->lo && raw <= s->lo;
+	case SCOPE_WINDOW:
+		return raw > s->hi || raw < s->lo;
+	default:
+		return 0;
+	}
+}
+
+/*
+	I2C中断里每个样本调用一次
+	返回1: 不要样本了(抓完了或者被Scope_Stop了)，采集停下突发读
+*/
+unsigned char Scope_Add(Scope_t *s,int16_t raw)
+{
+	if(s->state == SCOPE_PRE)
+	{
+		s->buf[s->head] = raw;
+		s->head = (s->head+1) & SCOPE_MASK;
+		//前面攒够pre个才判，触发时一定有pre个触发前的样本；至少要有一个前面的样本判边沿
+		if(s->fill >= s->pre && s->fill > 0 && Scope_Trigger(s,raw))
+		{
+			s->trig = (s->head-1) & SCOPE_MASK;
+			s->remain = s->post-1;
+			s->state = s->remain ? SCOPE_POST : SCOPE_DONE;
+		}
+		else if(s->fill < s->pre || s->fill == 0)
+			s->fill++;
+		s->last = raw;
+	}
+	else if(s->state == SCOPE_POST)
+	{
+		s->buf[s->head] = raw;
+		s->head = (s->head+1) & SCOPE_MASK;
+		if(--s->remain == 0)
+			s->state = SCOPE_DONE;
+	}
+	return s->state != SCOPE_PRE && s->state != SCOPE_POST;
+}
+
+//放弃这次抓取或者放掉冻结的缓冲
+void Scope_Stop(Scope_t *s)
+{
+	s->state = SCOPE_IDLE;
+	s->exporting = 0;
+}
+
+//冻结的样本数，没抓完是0
+uint16_t Scope_Count(Scope_t *s)
+{
+	return s->state == SCOPE_DONE ? s->pre+s->post : 0;
+}
+
+//冻结的第i个样本 uA，0是最早的，第pre个是触发那个
+int32_t Scope_Get(Scope_t *s,uint16_t i)
+{
+	return (int32_t)s->buf[(s->trig - s->pre + i) & SCOPE_MASK] * s->lsb;
+}
+
+/*
+	冻结的样本按CSV从PRINTF打出去: 时间(相对触发 us),电流(uA)
+	1024个点约12KB，115200波特要1秒多，这里只是开始，由主循环调Scope_ExportStep分几百轮打完
+	没抓完就什么也不做
+*/
+void Scope_Export(Scope_t *s)
+{
+	if(s->state != SCOPE_DONE)
+		return;
+	s->out = 0;
+	s->exporting = 1;
+}
+
+/*
+	主循环每轮调用一次: 第一轮先打表头，每轮最多SCOPE_EXPORT_LINES行，PRINTF是查询发送，一次阻塞几ms
+	返回1: 还没打完；中途被Scope_Stop放掉了就不打了
+*/
+unsigned char Scope_ExportStep(Scope_t *s)
+{
+	uint16_t i,n = Scope_Count(s);
+
+	if(!s->exporting)
+		return 0;
+	if(s->out == 0)
+	{
+		PRINTF("# scope %d samples, pre %d, %dus, trigger %d [%d,%d]uA\r\n",n,s->pre,s->period_us,s->mode,(int)s->lo_ua,(int)s->hi_ua);
+		PRINTF("t_us,uA\r\n");
+	}
+	for(i=0;i<SCOPE_EXPORT_LINES && s->out<n;i++,s->out++)
+		PRINTF("%d,%d\r\n",((int)s->out - (int)s->pre) * s->period_us,(int)Scope_Get(s,s->out));
+	if(s->out >= n)
+		s->exporting = 0;
+	return s->exporting;
+}
@@ -0,0 +1,60 @@
+#ifndef SCOPE_H
+#define SCOPE_H
+
+#include <stdint.h>
+
+/*
+	电流的突发抓取(像示波器的单次触发)
+	样本是INA226电流寄存器的原始值(int16，一个LSB是lsb uA)，在I2C中断里由Scope_Add一直写进环形缓冲，
+	攒够pre个触发前的样本以后开始判触发，触发后再收post个(含触发那个)就冻结，缓冲里的pre+post个留着给显示和导出
+	状态: Scope_Arm(界面) -> SCOPE_ARM -> Scope_Start(采集开始突发读) -> SCOPE_PRE -> 触发 -> SCOPE_POST -> SCOPE_DONE
+	      任何时候Scope_Stop回SCOPE_IDLE，采集看到不是PRE/POST就停下突发读
+	RAM: SCOPE_DEPTH*2字节，1024点2KB，140us一个点约143ms
+*/
+
+#define SCOPE_DEPTH   1024       //缓冲的样本数，2的幂
+#define SCOPE_EXPORT_LINES 4     //Scope_ExportStep每次最多打的CSV行数，一行十几个字节，115200波特约4ms
+
+#define SCOPE_IDLE    0          //没在抓
+#define SCOPE_ARM     1          //界面要抓，等主循环把INA226切到最快
+#define SCOPE_PRE     2          //在抓，攒触发前的样本/等触发
+#define SCOPE_POST    3          //触发了，收触发后的样本
+#define SCOPE_DONE    4          //抓完了，缓冲冻结
+
+#define SCOPE_LEVEL   0          //样本>=hi就触发
+#define SCOPE_RISE    1          //从hi以下升到>=hi(上升沿)
+#define SCOPE_FALL    2          //从lo以上降到<=lo(下降沿)
+#define SCOPE_WINDOW  3          //跑出[lo,hi]窗口，大于hi或小于lo
+
+typedef struct
+{
+	int16_t buf[SCOPE_DEPTH];    //环形，head是下一个要写的位置
+	volatile uint8_t state;      //SCOPE_xxx
+	uint8_t mode;                //SCOPE_LEVEL等
+	uint16_t pre;                //触发前的样本数
+	uint16_t post;               //触发后的样本数，含触发那个
+	uint16_t head;
+	uint16_t fill;               //开始以后收到的样本数，到pre(至少1)为止
+	uint16_t remain;             //触发后还要收几个
+	uint16_t trig;               //触发那个样本在buf里的位置
+	uint16_t period_us;          //样本间隔
+	int16_t lo;                  //换算成寄存器值的阈值
+	int16_t hi;
+	int16_t last;                //上一个样本，判边沿用
+	int32_t lo_ua;               //Scope_Arm给的阈值 uA
+	int32_t hi_ua;
+	int32_t lsb;                 //一个LSB多少uA
+	uint16_t out;                //CSV导出: 下一个要打的样本，0时先打表头
+	uint8_t exporting;           //1: Scope_Export开始了导出，主循环还在一轮轮打
+} Scope_t;
+
+void Scope_Arm(Scope_t *s,uint8_t mode,int32_t lo_ua,int32_t hi_ua,uint16_t pre,uint16_t post);
+void Scope_Start(Scope_t *s,int32_t lsb,uint16_t period_us);
+unsigned char Scope_Add(Scope_t *s,int16_t raw);
+void Scope_Stop(Scope_t *s);
+uint16_t Scope_Count(Scope_t *s);
+int32_t Scope_Get(Scope_t *s,uint16_t i);
+void Scope_Export(Scope_t *s);
+unsigned char Scope_ExportStep(Scope_t *s);
+
+#endif
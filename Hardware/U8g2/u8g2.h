@@ -176,6 +176,96 @@
 #endif
 
 
+/*
+  Partial refresh for the full buffer mode.
+  If a shadow buffer is assigned with u8g2_SetShadowBuffer(), then u8g2_SendBuffer()
+  compares each 8x8 tile with the copy of the last transmitted frame and only sends
+  the tiles which have changed. Without a shadow buffer the complete buffer is sent as before.
+  Requires one additional buffer with u8g2_GetBufferSize() bytes in RAM.
+*/
+#ifndef U8G2_WITHOUT_DIRTY_TILES
+#define U8G2_WITH_DIRTY_TILES
+#endif
+
+
+/*
+  Fast glyph search for unicode fonts with many glyphs (e.g. the wqy chinese fonts).
+  u8g2_SetFont() walks the unicode glyphs once and stores every n-th glyph in a
+  sparse index (n = number of glyphs / U8G2_GLYPH_INDEX_SIZE + 1). The glyph search
+  does a binary search on this index and a linear search over at most n glyphs.
+  The last U8G2_GLYPH_CACHE_SIZE resolved glyphs are kept in a LRU cache.
+  RAM: (U8G2_GLYPH_INDEX_SIZE + U8G2_GLYPH_CACHE_SIZE) * (2 + sizeof(pointer)) bytes
+*/
+#ifdef U8G2_WITH_UNICODE
+#ifndef U8G2_WITHOUT_GLYPH_INDEX
+#define U8G2_WITH_GLYPH_INDEX
+#endif
+#endif
+
+#ifndef U8G2_GLYPH_INDEX_SIZE
+#define U8G2_GLYPH_INDEX_SIZE 64
+#endif
+
+#ifndef U8G2_GLYPH_CACHE_SIZE
+#define U8G2_GLYPH_CACHE_SIZE 8
+#endif
+
+/*
+  Faster glyph drawing for the vertical top lsb buffer (SSD1306, SH1106, ...).
+  If the display is not rotated, the font direction is 0 and the glyph is inside 
+  the user window horizontally, the glyph is decoded into column bytes and merged 
+  into the buffer page by page. Other glyphs are drawn with u8g2_DrawHVLine() as before.
+  Uses U8G2_FAST_GLYPH_MAX_WIDTH bytes on the stack, wider glyphs are drawn as before.
+*/
+#ifndef U8G2_WITHOUT_FAST_GLYPH
+#define U8G2_WITH_FAST_GLYPH
+#endif
+
+#ifndef U8G2_FAST_GLYPH_MAX_WIDTH
+#define U8G2_FAST_GLYPH_MAX_WIDTH 32
+#endif
+
+/*
+  Fill kernel for the vertical top lsb buffer: u8g2_DrawBox() and horizontal 
+  lines with 8 or more pixel are written page by page and 32 bit at a time, 
+  vertical lines with one read-modify-write per page. The partial top and bottom
+  page use a precomputed mask. u8g2_DrawBox() uses the kernel only if the display 
+  is not rotated. This also speeds up u8g2_DrawFrame() and u8g2_DrawRFrame().
+*/
+#ifndef U8G2_WITHOUT_FAST_FILL
+#define U8G2_WITH_FAST_FILL
+#endif
+
+/*
+  Track the part of the buffer which has been modified since the last clear.
+  u8g2_ClearDrawnArea() clears only this rectangle instead of the complete buffer.
+*/
+#ifndef U8G2_WITHOUT_DRAWN_AREA
+#define U8G2_WITH_DRAWN_AREA
+#endif
+
+/*
+  u8g2_DrawFixed() and u8g2_DrawNumber() keep the glyph data pointers of 
+  "0123456789 +-." for the last font, so that the digits are not searched 
+  in the font for every call. RAM: 2 + U8G2_NUMBER_GLYPH_CNT pointers
+*/
+#ifndef U8G2_WITHOUT_NUMBER_GLYPHS
+#define U8G2_WITH_NUMBER_GLYPHS
+#endif
+
+#define U8G2_NUMBER_GLYPH_CNT 14
+
+/*
+  Display list: u8g2_BeginDisplayList() records the draw calls of one frame 
+  into a small command buffer instead of drawing them. u8g2_SendDisplayList()
+  replays the commands for each page of a page buffer (u8g2_Setup_..._1 and _2),
+  commands outside of the current page are skipped. See u8g2_dlist.c.
+*/
+#ifndef U8G2_WITHOUT_DISPLAY_LIST
+#define U8G2_WITH_DISPLAY_LIST
+#endif
+
+
 /*==========================================*/
 
 
@@ -311,6 +401,90 @@ struct u8g2_cb_struct
 typedef u8g2_uint_t (*u8g2_font_calc_vref_fnptr)(u8g2_t *u8g2);
 
 
+/*
+  Retained text, see u8g2_text_cache.c
+  A string is rendered once into buf (tile format, see u8g2_DrawTileBitmap)
+  and copied into the frame buffer on later calls.
+*/
+struct _u8g2_text_cache_t
+{
+  const uint8_t *font;		/* font of the rendered string, NULL: nothing rendered */
+  const char *str;		/* rendered string, only the pointer is compared */
+  uint8_t *buf;			/* bitmap in tile format, provided by the user */
+  uint16_t buf_size;		/* size of buf in bytes */
+  u8g2_uint_t width;		/* width of the bitmap in pixel */
+  u8g2_uint_t height;		/* height of the bitmap in pixel (max_char_height of the font) */
+  u8g2_uint_t left;		/* columns left of the reference position (negative x_offset of the font) */
+  u8g2_uint_t advance;		/* return value of u8g2_DrawUTF8() for this string */
+};
+typedef struct _u8g2_text_cache_t u8g2_text_cache_t;
+
+/*
+  Pre-rendered digits, see u8g2_number.c
+  The chars "0123456789 +-." and the unit letters are rendered into one cell
+  each: the advance of the char (1 byte) followed by the glyph in tile format
+  (left + advance columns).
+*/
+struct _u8g2_digit_cache_t
+{
+  const uint8_t *font;		/* font of the rendered cells, NULL: nothing rendered */
+  const char *units;		/* additional chars after "0123456789 +-.", may be NULL */
+  uint8_t *buf;			/* cells, provided by the user */
+  uint16_t buf_size;		/* size of buf in bytes */
+  uint8_t cnt;			/* number of rendered cells, chars which do not fit are drawn with u8g2_DrawGlyph() */
+  uint8_t advance;		/* largest advance of the chars, width of a cell without left */
+  uint8_t left;			/* columns left of the reference position (negative x_offset of the font) */
+  uint8_t height;		/* height of a cell in pixel (max_char_height of the font) */
+};
+typedef struct _u8g2_digit_cache_t u8g2_digit_cache_t;
+
+/*
+  Rectangle in buffer coordinates (not rotated, y relative to the current page),
+  x1 and y1 are excluded. Empty if x0 >= x1 or y0 >= y1.
+*/
+struct _u8g2_area_t
+{
+  u8g2_uint_t x0;
+  u8g2_uint_t y0;
+  u8g2_uint_t x1;
+  u8g2_uint_t y1;
+};
+typedef struct _u8g2_area_t u8g2_area_t;
+
+/*
+  Display list, see u8g2_dlist.c
+  buf contains the recorded commands, each command starts with a u8g2_dl_cmd_t header.
+*/
+struct _u8g2_dlist_t
+{
+  uint32_t *buf;		/* command buffer, provided by the user */
+  uint16_t buf_size;		/* size of buf in bytes */
+  uint16_t len;			/* recorded bytes */
+  uint16_t need;		/* bytes required for the last frame, larger than len if is_overflow is set */
+  uint16_t max_need;		/* largest value of need, use this to size buf */
+  uint8_t is_overflow;		/* buf was too small, some commands have been dropped */
+  
+  /* draw state of the last recorded command, a state command is added if this changes */
+  uint8_t is_state_valid;
+  uint8_t draw_color;
+  uint8_t is_transparent;
+  const uint8_t *font;
+  u8g2_font_calc_vref_fnptr font_calc_vref;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  u8g2_uint_t clip_x0, clip_y0, clip_x1, clip_y1;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+
+  /* buffer setup of the u8g2 object, restored by u8g2_EndDisplayList() */
+  u8g2_draw_ll_hvline_cb ll_hvline;
+  uint8_t tile_buf_height;
+  uint8_t tile_curr_row;
+#ifdef U8G2_WITH_DRAWN_AREA
+  u8g2_area_t drawn_area;
+#endif /* U8G2_WITH_DRAWN_AREA */
+};
+typedef struct _u8g2_dlist_t u8g2_dlist_t;
+
+
 struct u8g2_struct
 {
   u8x8_t u8x8;
@@ -383,6 +557,33 @@ struct u8g2_struct
 	// the following variable should be renamed to is_buffer_auto_clear
   uint8_t is_auto_page_clear; 		/* set to 0 to disable automatic clear of the buffer in firstPage() and nextPage() */
   
+#ifdef U8G2_WITH_DIRTY_TILES
+  uint8_t *shadow_buf_ptr;		/* copy of the last transmitted frame, NULL: always send the complete buffer */
+  uint8_t is_shadow_valid;		/* 0: content of the shadow buffer is unknown, the next send will transfer all tiles */
+#endif /* U8G2_WITH_DIRTY_TILES */
+
+#ifdef U8G2_WITH_GLYPH_INDEX
+  uint16_t glyph_index_encoding[U8G2_GLYPH_INDEX_SIZE];		/* encoding of every n-th unicode glyph, ascending */
+  const uint8_t *glyph_index_data[U8G2_GLYPH_INDEX_SIZE];	/* start of the glyph record (encoding) for the above entry */
+  uint8_t glyph_index_cnt;		/* used entries of the index, 0: no unicode glyphs */
+  uint16_t glyph_cache_encoding[U8G2_GLYPH_CACHE_SIZE];	/* LRU cache, most recent entry first */
+  const uint8_t *glyph_cache_data[U8G2_GLYPH_CACHE_SIZE];	/* glyph data as returned by u8g2_font_get_glyph_data() */
+  uint8_t glyph_cache_cnt;
+#endif /* U8G2_WITH_GLYPH_INDEX */
+
+#ifdef U8G2_WITH_NUMBER_GLYPHS
+  const uint8_t *number_glyph_font;	/* font of number_glyph_data, NULL: not yet looked up */
+  const uint8_t *number_glyph_data[U8G2_NUMBER_GLYPH_CNT];	/* "0123456789 +-.", NULL if not in the font */
+#endif /* U8G2_WITH_NUMBER_GLYPHS */
+
+#ifdef U8G2_WITH_DRAWN_AREA
+  u8g2_area_t drawn_area;		/* modified part of the buffer since the last u8g2_ClearBuffer() or u8g2_ClearDrawnArea() */
+#endif /* U8G2_WITH_DRAWN_AREA */
+
+#ifdef U8G2_WITH_DISPLAY_LIST
+  u8g2_dlist_t *dlist;		/* not NULL: draw calls are recorded into this list, see u8g2_BeginDisplayList() */
+#endif /* U8G2_WITH_DISPLAY_LIST */
+
 };
 
 #define u8g2_GetU8x8(u8g2) ((u8x8_t *)(u8g2))
@@ -694,6 +895,20 @@ void u8g2_SetBufferCurrTileRow(u8g2_t *u8g2, uint8_t row) U8G2_NOINLINE;
 void u8g2_FirstPage(u8g2_t *u8g2);
 uint8_t u8g2_NextPage(u8g2_t *u8g2);
 
+#ifdef U8G2_WITH_DIRTY_TILES
+void u8g2_SetShadowBuffer(u8g2_t *u8g2, uint8_t *buf);
+void u8g2_InvalidateShadowBuffer(u8g2_t *u8g2);
+uint16_t u8g2_UpdateShadowBuffer(u8g2_t *u8g2, uint8_t *first_row, uint8_t *last_row);
+#endif /* U8G2_WITH_DIRTY_TILES */
+
+void u8g2_ClearBufferArea(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);	/* buffer coordinates */
+
+#ifdef U8G2_WITH_DRAWN_AREA
+void u8g2_mark_drawn_area(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+void u8g2_InvalidateDrawnArea(u8g2_t *u8g2);
+void u8g2_ClearDrawnArea(u8g2_t *u8g2);
+#endif /* U8G2_WITH_DRAWN_AREA */
+
 // Add ability to set buffer pointer
 #ifdef __ARM_LINUX__
 #define U8G2_USE_DYNAMIC_ALLOC
@@ -734,6 +949,10 @@ void u8g2_WriteBufferXBM2(u8g2_t *u8g2, void (*out)(const char *s));
 
 /* SSD13xx, UC17xx, UC16xx */
 void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+#ifdef U8G2_WITH_FAST_FILL
+/* fill w x h pixel at x,y of the local buffer with color (0: clear, 1: set, 2: xor), all clipping done */
+void u8g2_ll_fill_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t color);
+#endif /* U8G2_WITH_FAST_FILL */
 /* ST7920 */
 void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 
@@ -758,6 +977,7 @@ void u8g2_DrawHorizontalBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_
 void u8g2_DrawBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t cnt, u8g2_uint_t h, const uint8_t *bitmap);
 void u8g2_DrawXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
 void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);	/* assumes bitmap in PROGMEM */
+void u8g2_DrawTileBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);	/* vertical top lsb, (h+7)/8 rows with w bytes */
 
 
 /*==========================================*/
@@ -850,6 +1070,8 @@ uint8_t u8g2_GetKerningByTable(u8g2_t *u8g2, const uint16_t *kt, uint16_t e1, ui
 
 u8g2_uint_t u8g2_add_vector_y(u8g2_uint_t dy, int8_t x, int8_t y, uint8_t dir) U8G2_NOINLINE;
 u8g2_uint_t u8g2_add_vector_x(u8g2_uint_t dx, int8_t x, int8_t y, uint8_t dir) U8G2_NOINLINE;
+const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding);
+int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data);	/* target_x/y must be set */
 
 
 size_t u8g2_GetFontSize(const uint8_t *font_arg);
@@ -901,6 +1123,59 @@ void u8g2_SetFontRefHeightText(u8g2_t *u8g2);
 void u8g2_SetFontRefHeightExtendedText(u8g2_t *u8g2);
 void u8g2_SetFontRefHeightAll(u8g2_t *u8g2);
 
+/*==========================================*/
+/* u8g2_text_cache.c */
+void u8g2_InitTextCache(u8g2_text_cache_t *tc, uint8_t *buf, uint16_t buf_size);
+void u8g2_InvalidateTextCache(u8g2_text_cache_t *tc);
+u8g2_uint_t u8g2_DrawUTF8Cached(u8g2_t *u8g2, u8g2_text_cache_t *tc, u8g2_uint_t x, u8g2_uint_t y, const char *str);
+u8g2_uint_t u8g2_render_tiles(u8g2_t *u8g2, uint8_t *buf, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t x, const char *str);
+
+/*==========================================*/
+/* u8g2_number.c */
+#define U8G2_FIX_ZERO U8X8_FIX_ZERO
+#define U8G2_FIX_PLUS U8X8_FIX_PLUS
+#define U8G2_FIX_LEFT U8X8_FIX_LEFT
+u8g2_uint_t u8g2_DrawFixed(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, int32_t v, uint8_t scale, uint8_t frac, uint8_t width, uint8_t flags);
+#define u8g2_DrawNumber(u8g2, x, y, v, width, flags) u8g2_DrawFixed((u8g2), (x), (y), (v), 0, 0, (width), (flags))
+void u8g2_InitDigitCache(u8g2_digit_cache_t *dc, uint8_t *buf, uint16_t buf_size, const char *units);
+u8g2_uint_t u8g2_DrawDigits(u8g2_t *u8g2, u8g2_digit_cache_t *dc, u8g2_uint_t x, u8g2_uint_t y, const char *str, const char *old);
+u8g2_uint_t u8g2_DrawFixedDigits(u8g2_t *u8g2, u8g2_digit_cache_t *dc, u8g2_uint_t x, u8g2_uint_t y, int32_t v, const int32_t *old, uint8_t scale, uint8_t frac, uint8_t width, uint8_t flags);
+#define u8g2_DrawNumberDigits(u8g2, dc, x, y, v, old, width, flags) u8g2_DrawFixedDigits((u8g2), (dc), (x), (y), (v), (old), 0, 0, (width), (flags))
+
+/*==========================================*/
+/* u8g2_dlist.c */
+#ifdef U8G2_WITH_DISPLAY_LIST
+void u8g2_InitDisplayList(u8g2_dlist_t *dl, uint32_t *buf, uint16_t buf_size);
+void u8g2_BeginDisplayList(u8g2_t *u8g2, u8g2_dlist_t *dl);
+void u8g2_EndDisplayList(u8g2_t *u8g2);
+void u8g2_DrawDisplayList(u8g2_t *u8g2, u8g2_dlist_t *dl);
+void u8g2_SendDisplayList(u8g2_t *u8g2, u8g2_dlist_t *dl);
+
+/* recorded commands, used by the draw procedures while a display list is active */
+#define U8G2_DL_FONT 1
+#define U8G2_DL_STYLE 2
+#define U8G2_DL_CLIP 3
+#define U8G2_DL_HVLINE 4
+#define U8G2_DL_BOX 5
+#define U8G2_DL_FRAME 6
+#define U8G2_DL_RBOX 7
+#define U8G2_DL_RFRAME 8
+#define U8G2_DL_TILE 9
+#define U8G2_DL_STR 10
+#define U8G2_DL_UTF8 11
+#define U8G2_DL_FIXED 12
+#define U8G2_DL_CLEAR 13
+#define U8G2_DL_CLEAR_DRAWN 14
+#define U8G2_DL_CLEAR_AREA 15
+#define U8G2_DL_DIGITS 16
+void u8g2_dl_box(u8g2_t *u8g2, uint8_t op, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r);
+void u8g2_dl_tile(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
+u8g2_uint_t u8g2_dl_str(u8g2_t *u8g2, uint8_t op, u8g2_uint_t x, u8g2_uint_t y, const char *str);
+u8g2_uint_t u8g2_dl_fixed(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, int32_t v, uint8_t scale, uint8_t frac, uint8_t width, uint8_t flags);
+void u8g2_dl_digits(u8g2_t *u8g2, u8g2_digit_cache_t *dc, u8g2_uint_t x, u8g2_uint_t y, const char *str);
+void u8g2_dl_clear(u8g2_t *u8g2, uint8_t op);
+#endif /* U8G2_WITH_DISPLAY_LIST */
+
 /*==========================================*/
 /* u8log_u8g2.c */
 void u8g2_DrawLog(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log);
@@ -955,6 +1230,7 @@ void u8g2_SetupBuffer_Utf8(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb);
 /* itoa procedures */
 #define u8g2_u8toa u8x8_u8toa
 #define u8g2_u16toa u8x8_u16toa
+#define u8g2_fixtoap u8x8_fixtoap
 
 
 /*==========================================*/
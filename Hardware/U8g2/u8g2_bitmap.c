@@ -273,3 +273,169 @@ void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
 }
 
 
+/*
+  Start position of a bitmap with len pixel. A bitmap which crosses the upper
+  end of u8g2_uint_t starts left of (or above) the display.
+*/
+static int32_t u8g2_tile_bitmap_start(u8g2_uint_t pos, u8g2_uint_t len)
+{
+  u8g2_uint_t end = pos;
+  end += len;
+  if ( end < pos )
+    return (int32_t)pos - ((int32_t)(u8g2_uint_t)~(u8g2_uint_t)0) - 1;
+  return pos;
+}
+
+/*
+  Fallback for buffers which are not vertical top lsb and for rotated displays.
+*/
+static void u8g2_draw_tile_bitmap_pixel(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  u8g2_uint_t c, r;
+  for( r = 0; r < h; r++ )
+  {
+    for( c = 0; c < w; c++ )
+    {
+      if ( u8x8_pgm_read(bitmap + (r>>3)*w + c) & (1<<(r&7)) )
+	u8g2_DrawPixel(u8g2, x+c, y+r);
+    }
+  }
+}
+
+/*
+  Combine bitmap bytes c0..c1-1 with the buffer bytes (ptr[c0]..ptr[c1-1]).
+*/
+static void u8g2_tile_bitmap_row(uint8_t *ptr, const uint8_t *src, int32_t c0, int32_t c1, uint8_t mask, uint8_t color)
+{
+  int32_t c;
+  switch(color)
+  {
+    case 0:
+      for( c = c0; c < c1; c++ )
+	ptr[c] &= ~(u8x8_pgm_read(src + c) & mask);
+      break;
+    case 1:
+      for( c = c0; c < c1; c++ )
+	ptr[c] |= u8x8_pgm_read(src + c) & mask;
+      break;
+    default:
+      for( c = c0; c < c1; c++ )
+	ptr[c] ^= u8x8_pgm_read(src + c) & mask;
+      break;
+  }
+}
+
+/*
+  Same as u8g2_tile_bitmap_row(), but the bitmap bytes are shifted down by 
+  shift bits (0 < shift < 8) or up by -shift bits (-8 < shift < 0).
+*/
+static void u8g2_tile_bitmap_row_shift(uint8_t *ptr, const uint8_t *src, int32_t c0, int32_t c1, uint8_t mask, int8_t shift, uint8_t color)
+{
+  int32_t c;
+  uint8_t b;
+  for( c = c0; c < c1; c++ )
+  {
+    b = u8x8_pgm_read(src + c) & mask;
+    if ( shift > 0 )
+      b <<= shift;
+    else
+      b >>= -shift;
+    if ( color == 1 )
+      ptr[c] |= b;
+    else if ( color == 0 )
+      ptr[c] &= ~b;
+    else
+      ptr[c] ^= b;
+  }
+}
+
+/*
+  x,y	Upper left position of the bitmap
+  w, h	Size of the bitmap in pixel
+  bitmap	(h+7)/8 rows with w bytes each. A byte is a vertical column of
+		8 pixel, lsb on top. This is the memory layout of the SSD1306 and 
+		the u8g2 buffer for these controllers ("tile format").
+		
+  Only set pixels are drawn (draw color 0: clear, 1: set, 2: xor).
+  For a vertical top lsb buffer without rotation, each bitmap byte is shifted 
+  into one or two bytes of the buffer. Otherwise the bitmap is drawn pixel by pixel.
+*/
+void u8g2_DrawTileBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  int32_t bx, by, dp;
+  int32_t c0, c1, r0, r1;
+  uint16_t p, p1;
+  uint8_t mask, shift;
+  uint8_t *ptr;
+  const uint8_t *src;
+
+  if ( w == 0 || h == 0 )
+    return;
+#ifdef U8G2_WITH_INTERSECTION
+  if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
+    return;
+#endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dlist != NULL )
+  {
+    u8g2_dl_tile(u8g2, x, y, w, h, bitmap);
+    return;
+  }
+#endif /* U8G2_WITH_DISPLAY_LIST */
+  
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb || u8g2->cb != U8G2_R0 )
+  {
+    u8g2_draw_tile_bitmap_pixel(u8g2, x, y, w, h, bitmap);
+    return;
+  }
+  
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+
+  /* visible columns and rows in bitmap coordinates */
+  bx = u8g2_tile_bitmap_start(x, w);
+  by = u8g2_tile_bitmap_start(y, h);
+  c0 = (int32_t)u8g2->user_x0 - bx;
+  c1 = (int32_t)u8g2->user_x1 - bx;
+  r0 = (int32_t)u8g2->user_y0 - by;
+  r1 = (int32_t)u8g2->user_y1 - by;
+  if ( c0 < 0 ) c0 = 0;
+  if ( r0 < 0 ) r0 = 0;
+  if ( c1 > (int32_t)w ) c1 = w;
+  if ( r1 > (int32_t)h ) r1 = h;
+  if ( c0 >= c1 || r0 >= r1 )
+    return;
+  
+  /* bitmap row 0 goes to bit "shift" of buffer page "dp" */
+  by -= u8g2->pixel_curr_row;
+#ifdef U8G2_WITH_DRAWN_AREA
+  u8g2_mark_drawn_area(u8g2, (u8g2_uint_t)(bx + c0), (u8g2_uint_t)(by + r0), (u8g2_uint_t)(c1 - c0), (u8g2_uint_t)(r1 - r0));
+#endif /* U8G2_WITH_DRAWN_AREA */
+  shift = (uint8_t)(by & 7);
+  dp = (by - shift) / 8;
+  
+  p1 = (uint16_t)((r1 - 1) >> 3);
+  for( p = (uint16_t)(r0 >> 3); p <= p1; p++ )
+  {
+    mask = 0x0ff;
+    if ( (int32_t)p*8 < r0 )
+      mask <<= r0 & 7;
+    if ( (int32_t)p*8 + 8 > r1 )
+      mask &= 0x0ff >> (8 - (r1 & 7));
+    
+    src = bitmap + (uint32_t)p*w;
+    ptr = u8g2->tile_buf_ptr + (dp + p) * (int32_t)u8g2->pixel_buf_width + bx;
+    /* rows outside of the user window are masked, so only touch pages which receive pixel */
+    if ( shift == 0 )
+      u8g2_tile_bitmap_row(ptr, src, c0, c1, mask, u8g2->draw_color);
+    else
+    {
+      if ( (uint8_t)(mask << shift) != 0 )
+	u8g2_tile_bitmap_row_shift(ptr, src, c0, c1, mask, shift, u8g2->draw_color);
+      if ( (mask >> (8-shift)) != 0 )
+	u8g2_tile_bitmap_row_shift(ptr + u8g2->pixel_buf_width, src, c0, c1, mask, shift-8, u8g2->draw_color);
+    }
+  }
+}
@@ -35,6 +35,51 @@
 
 #include "u8g2.h"
 
+#ifdef U8G2_WITH_FAST_FILL
+/*
+  Clip the box against the user window and fill it with one call to the fill kernel.
+  Returns 0 if the box must be drawn line by line: other buffer layout, 
+  display rotation or a box which wraps around (negative position).
+*/
+static uint8_t u8g2_draw_box_fast(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  u8g2_uint_t x1, y1;
+  
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb || u8g2->cb != U8G2_R0 )
+    return 0;
+  x1 = x;
+  x1 += w;
+  y1 = y;
+  y1 += h;
+  if ( x1 < x || y1 < y )
+    return 0;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return 1;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  
+  if ( x < u8g2->user_x0 )
+    x = u8g2->user_x0;
+  if ( x1 > u8g2->user_x1 )
+    x1 = u8g2->user_x1;
+  if ( y < u8g2->user_y0 )
+    y = u8g2->user_y0;
+  if ( y1 > u8g2->user_y1 )
+    y1 = u8g2->user_y1;
+  if ( x >= x1 || y >= y1 )
+    return 1;
+  
+  /* transform to pixel buffer coordinates */
+  y -= u8g2->pixel_curr_row;
+  y1 -= u8g2->pixel_curr_row;
+#ifdef U8G2_WITH_DRAWN_AREA
+  u8g2_mark_drawn_area(u8g2, x, y, x1-x, y1-y);
+#endif /* U8G2_WITH_DRAWN_AREA */
+  u8g2_ll_fill_vertical_top_lsb(u8g2, x, y, x1-x, y1-y, u8g2->draw_color);
+  return 1;
+}
+#endif /* U8G2_WITH_FAST_FILL */
+
 /*
   draw a filled box
   restriction: does not work for w = 0 or h = 0
@@ -45,6 +90,17 @@ void u8g2_DrawBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dlist != NULL )
+  {
+    u8g2_dl_box(u8g2, U8G2_DL_BOX, x, y, w, h, 0);
+    return;
+  }
+#endif /* U8G2_WITH_DISPLAY_LIST */
+#ifdef U8G2_WITH_FAST_FILL
+  if ( u8g2_draw_box_fast(u8g2, x, y, w, h) != 0 )
+    return;
+#endif /* U8G2_WITH_FAST_FILL */
   while( h != 0 )
   { 
     u8g2_DrawHVLine(u8g2, x, y, w, 0);
@@ -66,6 +122,13 @@ void u8g2_DrawFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dlist != NULL )
+  {
+    u8g2_dl_box(u8g2, U8G2_DL_FRAME, x, y, w, h, 0);
+    return;
+  }
+#endif /* U8G2_WITH_DISPLAY_LIST */
   
   u8g2_DrawHVLine(u8g2, x, y, w, 0);
   if (h >= 2) {
@@ -94,6 +157,13 @@ void u8g2_DrawRBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dlist != NULL )
+  {
+    u8g2_dl_box(u8g2, U8G2_DL_RBOX, x, y, w, h, r);
+    return;
+  }
+#endif /* U8G2_WITH_DISPLAY_LIST */
 
   xl = x;
   xl += r;
@@ -152,6 +222,13 @@ void u8g2_DrawRFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w,
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dlist != NULL )
+  {
+    u8g2_dl_box(u8g2, U8G2_DL_RFRAME, x, y, w, h, r);
+    return;
+  }
+#endif /* U8G2_WITH_DISPLAY_LIST */
 
   xl = x;
   xl += r;
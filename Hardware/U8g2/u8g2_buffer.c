@@ -40,12 +40,119 @@
 void u8g2_ClearBuffer(u8g2_t *u8g2)
 {
   size_t cnt;
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dlist != NULL )
+  {
+    u8g2_dl_clear(u8g2, U8G2_DL_CLEAR);
+    return;
+  }
+#endif /* U8G2_WITH_DISPLAY_LIST */
   cnt = u8g2_GetU8x8(u8g2)->display_info->tile_width;
   cnt *= u8g2->tile_buf_height;
   cnt *= 8;
   memset(u8g2->tile_buf_ptr, 0, cnt);
+#ifdef U8G2_WITH_DRAWN_AREA
+  u8g2->drawn_area.x0 = ~(u8g2_uint_t)0;
+  u8g2->drawn_area.y0 = ~(u8g2_uint_t)0;
+  u8g2->drawn_area.x1 = 0;
+  u8g2->drawn_area.y1 = 0;
+#endif /* U8G2_WITH_DRAWN_AREA */
+}
+
+/*
+  Clear a rectangle of the buffer (buffer coordinates: not rotated, y relative to 
+  the current page). The rectangle is clipped against the buffer.
+*/
+void u8g2_ClearBufferArea(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  uint8_t draw_color;
+  
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dlist != NULL )
+  {
+    u8g2_dl_box(u8g2, U8G2_DL_CLEAR_AREA, x, y, w, h, 0);
+    return;
+  }
+#endif /* U8G2_WITH_DISPLAY_LIST */
+  if ( x >= u8g2->pixel_buf_width || y >= u8g2->pixel_buf_height )
+    return;
+  if ( w > u8g2->pixel_buf_width - x )
+    w = u8g2->pixel_buf_width - x;
+  if ( h > u8g2->pixel_buf_height - y )
+    h = u8g2->pixel_buf_height - y;
+  if ( w == 0 || h == 0 )
+    return;
+  
+#ifdef U8G2_WITH_FAST_FILL
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+  {
+    u8g2_ll_fill_vertical_top_lsb(u8g2, x, y, w, h, 0);
+    return;
+  }
+#endif /* U8G2_WITH_FAST_FILL */
+  
+  draw_color = u8g2->draw_color;
+  u8g2->draw_color = 0;
+  do
+  {
+    u8g2->ll_hvline(u8g2, x, y, w, 0);
+    y++;
+    h--;
+  } while( h != 0 );
+  u8g2->draw_color = draw_color;
+}
+
+#ifdef U8G2_WITH_DRAWN_AREA
+
+/* x, y: buffer coordinates */
+void u8g2_mark_drawn_area(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  u8g2_area_t *a = &(u8g2->drawn_area);
+  if ( x < a->x0 )
+    a->x0 = x;
+  if ( y < a->y0 )
+    a->y0 = y;
+  x += w;
+  y += h;
+  if ( x > a->x1 )
+    a->x1 = x;
+  if ( y > a->y1 )
+    a->y1 = y;
 }
 
+/* the content of the buffer is unknown, the next u8g2_ClearDrawnArea() clears the complete buffer */
+void u8g2_InvalidateDrawnArea(u8g2_t *u8g2)
+{
+  u8g2->drawn_area.x0 = 0;
+  u8g2->drawn_area.y0 = 0;
+  u8g2->drawn_area.x1 = ~(u8g2_uint_t)0;
+  u8g2->drawn_area.y1 = ~(u8g2_uint_t)0;
+}
+
+/*
+  Same result as u8g2_ClearBuffer(), but only the area which has been 
+  modified since the last clear is written.
+*/
+void u8g2_ClearDrawnArea(u8g2_t *u8g2)
+{
+  u8g2_area_t *a = &(u8g2->drawn_area);
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dlist != NULL )
+  {
+    u8g2_dl_clear(u8g2, U8G2_DL_CLEAR_DRAWN);
+    return;
+  }
+#endif /* U8G2_WITH_DISPLAY_LIST */
+  if ( a->x0 < a->x1 && a->y0 < a->y1 )
+    u8g2_ClearBufferArea(u8g2, a->x0, a->y0, a->x1 - a->x0, a->y1 - a->y0);
+  a->x0 = ~(u8g2_uint_t)0;
+  a->y0 = ~(u8g2_uint_t)0;
+  a->x1 = 0;
+  a->y1 = 0;
+}
+
+#endif /* U8G2_WITH_DRAWN_AREA */
+
 /*============================================*/
 
 static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_tile_row)
@@ -89,10 +196,144 @@ static void u8g2_send_buffer(u8g2_t *u8g2)
   } while( src_row < src_max && dest_row < dest_max );
 }
 
+#ifdef U8G2_WITH_DIRTY_TILES
+
+/*
+  Two dirty tile runs in the same tile row are merged, if they are separated
+  by not more than this number of unchanged tiles. Sending one unchanged tile
+  (8 data bytes) is cheaper than the position commands of an additional run.
+*/
+#ifndef U8G2_DIRTY_TILE_GAP
+#define U8G2_DIRTY_TILE_GAP 1
+#endif
+
+static uint8_t u8g2_is_shadow_active(u8g2_t *u8g2)
+{
+  if ( u8g2->shadow_buf_ptr == NULL )
+    return 0;
+  /* only the full buffer mode keeps the complete frame in RAM */
+  if ( u8g2->tile_buf_height != u8g2_GetU8x8(u8g2)->display_info->tile_height )
+    return 0;
+  return 1;
+}
+
+/* compare one tile with the shadow buffer, copy it to the shadow buffer if it differs, return 1 for a changed tile */
+static uint8_t u8g2_sync_shadow_tile(u8g2_t *u8g2, uint16_t offset)
+{
+  uint8_t *src = u8g2->tile_buf_ptr + offset;
+  uint8_t *shadow = u8g2->shadow_buf_ptr + offset;
+  
+  if ( u8g2->is_shadow_valid != 0 && memcmp(src, shadow, 8) == 0 )
+    return 0;
+  memcpy(shadow, src, 8);
+  return 1;
+}
+
+/* send only those tile spans, which differ from the shadow buffer */
+static void u8g2_send_dirty_tiles(u8g2_t *u8g2)
+{
+  uint8_t *ptr;
+  uint16_t offset;
+  uint8_t w;
+  uint8_t tx, ty;
+  uint8_t run_start, run_end;		/* run_end is excluded */
+  
+  w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  offset = 0;
+  for( ty = 0; ty < u8g2->tile_buf_height; ty++ )
+  {
+    ptr = u8g2->tile_buf_ptr + offset;
+    run_start = 0xff;
+    run_end = 0;
+    for( tx = 0; tx < w; tx++ )
+    {
+      if ( u8g2_sync_shadow_tile(u8g2, offset + (uint16_t)tx*8) != 0 )
+      {
+	if ( run_start == 0xff )
+	  run_start = tx;
+	run_end = tx+1;
+      }
+      else if ( run_start != 0xff && tx - run_end >= U8G2_DIRTY_TILE_GAP )
+      {
+	u8x8_DrawTile(u8g2_GetU8x8(u8g2), run_start, ty, run_end-run_start, ptr + run_start*8);
+	run_start = 0xff;
+      }
+    }
+    if ( run_start != 0xff )
+      u8x8_DrawTile(u8g2_GetU8x8(u8g2), run_start, ty, run_end-run_start, ptr + run_start*8);
+    offset += (uint16_t)w*8;
+  }
+  u8g2->is_shadow_valid = 1;
+}
+
+/*
+  Assign the shadow buffer for the partial refresh, buf must have u8g2_GetBufferSize() bytes.
+  Use NULL to disable the partial refresh. The next u8g2_SendBuffer() will always send all tiles.
+*/
+void u8g2_SetShadowBuffer(u8g2_t *u8g2, uint8_t *buf)
+{
+  u8g2->shadow_buf_ptr = buf;
+  u8g2->is_shadow_valid = 0;
+}
+
+/* call this if the display RAM was modified without u8g2_SendBuffer() (e.g. by u8x8 procedures) */
+void u8g2_InvalidateShadowBuffer(u8g2_t *u8g2)
+{
+  u8g2->is_shadow_valid = 0;
+}
+
+/*
+  For drivers which transfer the buffer by other means (e.g. DMA):
+  Compare the buffer with the shadow buffer and update the shadow buffer.
+  Returns the number of changed tiles. If this is not zero, then first_row and last_row
+  (both included) contain the tile rows which must be transferred.
+  Without shadow buffer, all tile rows are reported as changed.
+*/
+uint16_t u8g2_UpdateShadowBuffer(u8g2_t *u8g2, uint8_t *first_row, uint8_t *last_row)
+{
+  uint16_t offset;
+  uint8_t w;
+  uint8_t tx, ty;
+  uint16_t cnt;
+  
+  w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  *first_row = 0;
+  *last_row = u8g2->tile_buf_height-1;
+  if ( u8g2_is_shadow_active(u8g2) == 0 )
+    return (uint16_t)w*u8g2->tile_buf_height;
+  
+  cnt = 0;
+  offset = 0;
+  for( ty = 0; ty < u8g2->tile_buf_height; ty++ )
+  {
+    for( tx = 0; tx < w; tx++ )
+    {
+      if ( u8g2_sync_shadow_tile(u8g2, offset) != 0 )
+      {
+	if ( cnt == 0 )
+	  *first_row = ty;
+	*last_row = ty;
+	cnt++;
+      }
+      offset += 8;
+    }
+  }
+  u8g2->is_shadow_valid = 1;
+  return cnt;
+}
+
+#endif /* U8G2_WITH_DIRTY_TILES */
+
 /* same as u8g2_send_buffer but also send the DISPLAY_REFRESH message (used by SSD1606) */
+/* with a shadow buffer (U8G2_WITH_DIRTY_TILES), only the changed tiles are sent */
 void u8g2_SendBuffer(u8g2_t *u8g2)
 {
-  u8g2_send_buffer(u8g2);
+#ifdef U8G2_WITH_DIRTY_TILES
+  if ( u8g2_is_shadow_active(u8g2) )
+    u8g2_send_dirty_tiles(u8g2);
+  else
+#endif /* U8G2_WITH_DIRTY_TILES */
+    u8g2_send_buffer(u8g2);
   u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );  
 }
 
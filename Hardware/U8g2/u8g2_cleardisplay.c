@@ -50,5 +50,8 @@ void u8g2_ClearDisplay(u8g2_t *u8g2)
     A workaround would be, that the user sets the current tile row to 0 manually.
   */
   u8g2_SetBufferCurrTileRow(u8g2, 0);  
+#ifdef U8G2_WITH_DIRTY_TILES
+  u8g2_InvalidateShadowBuffer(u8g2);	/* display RAM was written without the shadow buffer */
+#endif /* U8G2_WITH_DIRTY_TILES */
 }
 
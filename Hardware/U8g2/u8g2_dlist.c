@@ -0,0 +1,540 @@
+/*
+
+  u8g2_dlist.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Display list: The draw calls of one frame are recorded once and replayed
+  for each page of a page buffer. With u8g2_Setup_..._2 only 256 bytes
+  frame buffer are required for a 128x64 display and the drawing code is
+  executed once per frame instead of once per page:
+
+    u8g2_BeginDisplayList(u8g2, &dl);
+    ... draw ...
+    u8g2_EndDisplayList(u8g2);
+    u8g2_SendDisplayList(u8g2, &dl);
+
+  u8g2_DrawBox(), u8g2_DrawFrame(), u8g2_DrawRBox(), u8g2_DrawRFrame(),
+  u8g2_DrawTileBitmap(), u8g2_DrawStr(), u8g2_DrawUTF8(), u8g2_DrawFixed(),
+  u8g2_DrawDigits() and the clear procedures are recorded as one command together with the
+  tile rows they touch. All other draw procedures are recorded as the
+  clipped lines which they produce. Commands outside of the current page
+  are skipped during the replay.
+
+  Font, font position, font mode, draw color and clip window are recorded
+  when they differ from the previous command. Strings are copied into the
+  list (at most U8G2_DL_STR_MAX bytes), bitmaps are not: A bitmap (and the
+  cells of a digit cache) must not change until the list has been sent.
+
+  If buf is too small, the remaining commands of the frame are dropped and
+  is_overflow is set. max_need is the size which would have been required.
+
+*/
+
+#include "u8g2.h"
+#include <stddef.h>
+#include <string.h>
+
+#ifdef U8G2_WITH_DISPLAY_LIST
+
+struct _u8g2_dl_cmd_t
+{
+  uint8_t op;			/* U8G2_DL_xxx */
+  uint8_t size;			/* size of the command in bytes, multiple of U8G2_DL_ALIGN */
+  uint8_t row0;			/* first and last tile row which is touched by the command */
+  uint8_t row1;
+  union
+  {
+    struct { const uint8_t *font; u8g2_font_calc_vref_fnptr font_calc_vref; } font;
+    struct { uint8_t draw_color; uint8_t is_transparent; } style;
+    struct { u8g2_uint_t x0, y0, x1, y1; } clip;
+    struct { u8g2_uint_t x, y, len; uint8_t dir; uint8_t color; } hv;	/* buffer coordinates, no page offset */
+    struct { u8g2_uint_t x, y, w, h, r; } box;
+    struct { const uint8_t *bitmap; u8g2_uint_t x, y, w, h; } tile;
+    struct { u8g2_uint_t x, y; char s[1]; } str;
+    struct { u8g2_digit_cache_t *dc; u8g2_uint_t x, y; char s[1]; } digits;
+    struct { int32_t v; u8g2_uint_t x, y; uint8_t scale, frac, width, flags; } fixed;
+  } u;
+};
+typedef struct _u8g2_dl_cmd_t u8g2_dl_cmd_t;
+
+/* commands are stored back to back, each one has to start at the alignment of the union (pointers: 4 on the target, 8 on a 64 bit host) */
+struct _u8g2_dl_align_t { char c; u8g2_dl_cmd_t cmd; };
+#define U8G2_DL_ALIGN offsetof(struct _u8g2_dl_align_t, cmd)
+#define U8G2_DL_ROUND(n) (((n) + U8G2_DL_ALIGN - 1) & ~(U8G2_DL_ALIGN - 1))
+#define U8G2_DL_SIZE(member) U8G2_DL_ROUND(offsetof(u8g2_dl_cmd_t, u) + sizeof(((u8g2_dl_cmd_t *)0)->u.member))
+#define U8G2_DL_STR_MAX (256 - U8G2_DL_ALIGN - offsetof(u8g2_dl_cmd_t, u.str.s) - 1)
+
+/*==========================================*/
+/* record */
+
+/* append a command with "size" bytes, returns NULL if there is no space left */
+static u8g2_dl_cmd_t *u8g2_dl_add(u8g2_dlist_t *dl, uint8_t op, uint8_t size)
+{
+  u8g2_dl_cmd_t *c;
+
+  if ( (uint32_t)dl->need + size > 0x0ffff )
+    dl->need = 0x0ffff;
+  else
+    dl->need += size;
+  if ( dl->is_overflow != 0 || dl->len + size > dl->buf_size )
+  {
+    dl->is_overflow = 1;
+    return NULL;
+  }
+  c = (u8g2_dl_cmd_t *)((uint8_t *)dl->buf + dl->len);
+  dl->len += size;
+  c->op = op;
+  c->size = size;
+  c->row0 = 0;
+  c->row1 = 255;
+  return c;
+}
+
+/* tile rows of the pixel rows y..y+h-1 */
+static void u8g2_dl_rows(u8g2_dl_cmd_t *c, u8g2_uint_t y, u8g2_uint_t h)
+{
+  u8g2_uint_t y1 = y;
+
+  if ( h == 0 )
+    return;
+  y1 += h;
+  if ( y1 < y )
+    y = 0;	/* starts above the display */
+  y1--;
+  y >>= 3;
+  y1 >>= 3;
+  c->row0 = y > 255 ? 255 : y;
+  c->row1 = y1 > 255 ? 255 : y1;
+}
+
+/* same as u8g2_dl_rows() for user coordinates: no culling for rotated displays */
+static void u8g2_dl_user_rows(u8g2_t *u8g2, u8g2_dl_cmd_t *c, u8g2_uint_t y, u8g2_uint_t h)
+{
+  if ( u8g2->cb == U8G2_R0 )
+    u8g2_dl_rows(c, y, h);
+}
+
+/* rows of the font bounding box for the reference position y */
+static void u8g2_dl_font_rows(u8g2_t *u8g2, u8g2_dl_cmd_t *c, u8g2_uint_t y)
+{
+  u8g2_uint_t ascent;
+
+#ifdef U8G2_WITH_FONT_ROTATION
+  if ( u8g2->font_decode.dir != 0 )
+    return;
+#endif
+  ascent = u8g2->font_info.max_char_height;
+  ascent += u8g2->font_info.y_offset;
+  y += u8g2->font_calc_vref(u8g2);
+  y -= ascent;
+  u8g2_dl_user_rows(u8g2, c, y, u8g2->font_info.max_char_height);
+}
+
+/* record the draw state if it differs from the state of the previous command */
+static void u8g2_dl_sync(u8g2_t *u8g2, u8g2_dlist_t *dl)
+{
+  u8g2_dl_cmd_t *c;
+
+  if ( dl->is_state_valid == 0 || dl->font != u8g2->font || dl->font_calc_vref != u8g2->font_calc_vref )
+  {
+    c = u8g2_dl_add(dl, U8G2_DL_FONT, U8G2_DL_SIZE(font));
+    if ( c != NULL )
+    {
+      c->u.font.font = u8g2->font;
+      c->u.font.font_calc_vref = u8g2->font_calc_vref;
+    }
+    dl->font = u8g2->font;
+    dl->font_calc_vref = u8g2->font_calc_vref;
+  }
+  if ( dl->is_state_valid == 0 || dl->draw_color != u8g2->draw_color || dl->is_transparent != u8g2->font_decode.is_transparent )
+  {
+    c = u8g2_dl_add(dl, U8G2_DL_STYLE, U8G2_DL_SIZE(style));
+    if ( c != NULL )
+    {
+      c->u.style.draw_color = u8g2->draw_color;
+      c->u.style.is_transparent = u8g2->font_decode.is_transparent;
+    }
+    dl->draw_color = u8g2->draw_color;
+    dl->is_transparent = u8g2->font_decode.is_transparent;
+  }
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( dl->is_state_valid == 0 || dl->clip_x0 != u8g2->clip_x0 || dl->clip_y0 != u8g2->clip_y0
+	|| dl->clip_x1 != u8g2->clip_x1 || dl->clip_y1 != u8g2->clip_y1 )
+  {
+    c = u8g2_dl_add(dl, U8G2_DL_CLIP, U8G2_DL_SIZE(clip));
+    if ( c != NULL )
+    {
+      c->u.clip.x0 = u8g2->clip_x0;
+      c->u.clip.y0 = u8g2->clip_y0;
+      c->u.clip.x1 = u8g2->clip_x1;
+      c->u.clip.y1 = u8g2->clip_y1;
+    }
+    dl->clip_x0 = u8g2->clip_x0;
+    dl->clip_y0 = u8g2->clip_y0;
+    dl->clip_x1 = u8g2->clip_x1;
+    dl->clip_y1 = u8g2->clip_y1;
+  }
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  dl->is_state_valid = 1;
+}
+
+static u8g2_dl_cmd_t *u8g2_dl_draw_cmd(u8g2_t *u8g2, uint8_t op, uint8_t size)
+{
+  u8g2_dl_sync(u8g2, u8g2->dlist);
+  return u8g2_dl_add(u8g2->dlist, op, size);
+}
+
+/*
+  ll_hvline procedure while recording. Used by all draw procedures which are
+  not recorded as a command. x and y are already clipped to the display and
+  the clip window.
+*/
+static void u8g2_dl_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  u8g2_dl_cmd_t *c = u8g2_dl_add(u8g2->dlist, U8G2_DL_HVLINE, U8G2_DL_SIZE(hv));
+  if ( c == NULL )
+    return;
+  c->u.hv.x = x;
+  c->u.hv.y = y;
+  c->u.hv.len = len;
+  c->u.hv.dir = dir;
+  c->u.hv.color = u8g2->draw_color;
+  u8g2_dl_rows(c, y, dir == 0 ? 1 : len);
+}
+
+void u8g2_dl_box(u8g2_t *u8g2, uint8_t op, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r)
+{
+  u8g2_dl_cmd_t *c = u8g2_dl_draw_cmd(u8g2, op, U8G2_DL_SIZE(box));
+  if ( c == NULL )
+    return;
+  c->u.box.x = x;
+  c->u.box.y = y;
+  c->u.box.w = w;
+  c->u.box.h = h;
+  c->u.box.r = r;
+  if ( op == U8G2_DL_CLEAR_AREA )
+    u8g2_dl_rows(c, y, h);	/* buffer coordinates */
+  else
+    u8g2_dl_user_rows(u8g2, c, y, h);
+}
+
+void u8g2_dl_tile(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  u8g2_dl_cmd_t *c = u8g2_dl_draw_cmd(u8g2, U8G2_DL_TILE, U8G2_DL_SIZE(tile));
+  if ( c == NULL )
+    return;
+  c->u.tile.bitmap = bitmap;
+  c->u.tile.x = x;
+  c->u.tile.y = y;
+  c->u.tile.w = w;
+  c->u.tile.h = h;
+  u8g2_dl_user_rows(u8g2, c, y, h);
+}
+
+/* sum of the glyph delta x values, same as the return value of u8g2_DrawStr() */
+static u8g2_uint_t u8g2_dl_str_width(u8g2_t *u8g2, const char *str)
+{
+  uint16_t e;
+  u8g2_uint_t sum = 0;
+
+  u8x8_utf8_init(u8g2_GetU8x8(u8g2));
+  for(;;)
+  {
+    e = u8g2->u8x8.next_cb(u8g2_GetU8x8(u8g2), (uint8_t)*str);
+    if ( e == 0x0ffff )
+      break;
+    str++;
+    if ( e != 0x0fffe )
+      sum += u8g2_GetGlyphWidth(u8g2, e);
+  }
+  return sum;
+}
+
+/* u8x8.next_cb must be set for op (U8G2_DL_STR or U8G2_DL_UTF8) */
+u8g2_uint_t u8g2_dl_str(u8g2_t *u8g2, uint8_t op, u8g2_uint_t x, u8g2_uint_t y, const char *str)
+{
+  u8g2_dl_cmd_t *c;
+  size_t n;
+
+  if ( u8g2->font == NULL )
+    return 0;
+  n = strlen(str);
+  if ( n > U8G2_DL_STR_MAX )
+    n = U8G2_DL_STR_MAX;
+  c = u8g2_dl_draw_cmd(u8g2, op, U8G2_DL_ROUND(offsetof(u8g2_dl_cmd_t, u.str.s) + n + 1));
+  if ( c != NULL )
+  {
+    c->u.str.x = x;
+    c->u.str.y = y;
+    memcpy(c->u.str.s, str, n);
+    c->u.str.s[n] = '\0';
+    u8g2_dl_font_rows(u8g2, c, y);
+  }
+  return u8g2_dl_str_width(u8g2, str);
+}
+
+u8g2_uint_t u8g2_dl_fixed(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, int32_t v, uint8_t scale, uint8_t frac, uint8_t width, uint8_t flags)
+{
+  char buf[U8X8_FIX_SIZE];
+  u8g2_dl_cmd_t *c = u8g2_dl_draw_cmd(u8g2, U8G2_DL_FIXED, U8G2_DL_SIZE(fixed));
+  if ( c != NULL )
+  {
+    c->u.fixed.v = v;
+    c->u.fixed.x = x;
+    c->u.fixed.y = y;
+    c->u.fixed.scale = scale;
+    c->u.fixed.frac = frac;
+    c->u.fixed.width = width;
+    c->u.fixed.flags = flags;
+    u8g2_dl_font_rows(u8g2, c, y);
+  }
+  u8x8_fixtoap(buf, v, scale, frac, width, flags);
+  u8g2->u8x8.next_cb = u8x8_ascii_next;
+  return u8g2_dl_str_width(u8g2, buf);
+}
+
+/* u8g2_DrawDigits() without old string, the cells are drawn from dc->buf during the replay */
+void u8g2_dl_digits(u8g2_t *u8g2, u8g2_digit_cache_t *dc, u8g2_uint_t x, u8g2_uint_t y, const char *str)
+{
+  u8g2_dl_cmd_t *c;
+  size_t n;
+
+  n = strlen(str);
+  if ( n > U8G2_DL_STR_MAX )
+    n = U8G2_DL_STR_MAX;
+  c = u8g2_dl_draw_cmd(u8g2, U8G2_DL_DIGITS, U8G2_DL_ROUND(offsetof(u8g2_dl_cmd_t, u.digits.s) + n + 1));
+  if ( c == NULL )
+    return;
+  c->u.digits.dc = dc;
+  c->u.digits.x = x;
+  c->u.digits.y = y;
+  memcpy(c->u.digits.s, str, n);
+  c->u.digits.s[n] = '\0';
+  u8g2_dl_font_rows(u8g2, c, y);
+}
+
+/* U8G2_DL_CLEAR or U8G2_DL_CLEAR_DRAWN */
+void u8g2_dl_clear(u8g2_t *u8g2, uint8_t op)
+{
+  u8g2_dl_add(u8g2->dlist, op, offsetof(u8g2_dl_cmd_t, u));
+}
+
+/*==========================================*/
+/* user interface */
+
+void u8g2_InitDisplayList(u8g2_dlist_t *dl, uint32_t *buf, uint16_t buf_size)
+{
+  uint16_t pad = (uint16_t)(-(uintptr_t)buf & (U8G2_DL_ALIGN - 1));	/* uint32_t is only 4 byte aligned on a 64 bit host */
+
+  if ( pad > buf_size )
+    pad = buf_size;
+  dl->buf = (uint32_t *)((uint8_t *)buf + pad);
+  dl->buf_size = (buf_size - pad) & ~(U8G2_DL_ALIGN - 1);
+  dl->len = 0;
+  dl->need = 0;
+  dl->max_need = 0;
+  dl->is_overflow = 0;
+}
+
+/*
+  Start recording. Until u8g2_EndDisplayList() the draw procedures do not
+  modify the buffer. The user window is the complete display.
+*/
+void u8g2_BeginDisplayList(u8g2_t *u8g2, u8g2_dlist_t *dl)
+{
+  dl->len = 0;
+  dl->need = 0;
+  dl->is_overflow = 0;
+  dl->is_state_valid = 0;
+
+  dl->ll_hvline = u8g2->ll_hvline;
+  dl->tile_buf_height = u8g2->tile_buf_height;
+  dl->tile_curr_row = u8g2->tile_curr_row;
+#ifdef U8G2_WITH_DRAWN_AREA
+  dl->drawn_area = u8g2->drawn_area;
+#endif /* U8G2_WITH_DRAWN_AREA */
+
+  u8g2->ll_hvline = u8g2_dl_hvline;
+  u8g2->tile_buf_height = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  u8g2_SetBufferCurrTileRow(u8g2, 0);
+  u8g2->dlist = dl;
+}
+
+void u8g2_EndDisplayList(u8g2_t *u8g2)
+{
+  u8g2_dlist_t *dl = u8g2->dlist;
+
+  if ( dl == NULL )
+    return;
+  u8g2->dlist = NULL;
+  u8g2->ll_hvline = dl->ll_hvline;
+  u8g2->tile_buf_height = dl->tile_buf_height;
+  u8g2_SetBufferCurrTileRow(u8g2, dl->tile_curr_row);
+#ifdef U8G2_WITH_DRAWN_AREA
+  u8g2->drawn_area = dl->drawn_area;
+#endif /* U8G2_WITH_DRAWN_AREA */
+  if ( dl->need > dl->max_need )
+    dl->max_need = dl->need;
+}
+
+/*==========================================*/
+/* replay */
+
+static void u8g2_dl_draw_hvline(u8g2_t *u8g2, const u8g2_dl_cmd_t *c)
+{
+  u8g2_uint_t y = c->u.hv.y;
+  u8g2_uint_t len = c->u.hv.len;
+  u8g2_uint_t y1 = u8g2->pixel_curr_row;
+  uint8_t draw_color = u8g2->draw_color;
+
+  y1 += u8g2->pixel_buf_height;
+  if ( c->u.hv.dir != 0 )
+  {
+    /* clip the vertical line against the current page */
+    if ( y < u8g2->pixel_curr_row )
+    {
+      len -= u8g2->pixel_curr_row - y;
+      y = u8g2->pixel_curr_row;
+    }
+    if ( len > y1 - y )
+      len = y1 - y;
+  }
+  y -= u8g2->pixel_curr_row;
+#ifdef U8G2_WITH_DRAWN_AREA
+  if ( c->u.hv.dir == 0 )
+    u8g2_mark_drawn_area(u8g2, c->u.hv.x, y, len, 1);
+  else
+    u8g2_mark_drawn_area(u8g2, c->u.hv.x, y, 1, len);
+#endif /* U8G2_WITH_DRAWN_AREA */
+  u8g2->draw_color = c->u.hv.color;
+  u8g2->ll_hvline(u8g2, c->u.hv.x, y, len, c->u.hv.dir);
+  u8g2->draw_color = draw_color;
+}
+
+static void u8g2_dl_clear_area(u8g2_t *u8g2, const u8g2_dl_cmd_t *c)
+{
+  u8g2_uint_t y = c->u.box.y;
+  u8g2_uint_t h = c->u.box.h;
+
+  if ( y < u8g2->pixel_curr_row )
+  {
+    h -= u8g2->pixel_curr_row - y;
+    y = u8g2->pixel_curr_row;
+  }
+  u8g2_ClearBufferArea(u8g2, c->u.box.x, y - u8g2->pixel_curr_row, c->u.box.w, h);
+}
+
+/*
+  Draw the recorded commands into the current page. Font, draw color,
+  font mode and clip window are set as recorded.
+*/
+void u8g2_DrawDisplayList(u8g2_t *u8g2, u8g2_dlist_t *dl)
+{
+  const uint8_t *p = (const uint8_t *)dl->buf;
+  const uint8_t *end = p + dl->len;
+  const u8g2_dl_cmd_t *c;
+  uint8_t row0 = u8g2->tile_curr_row;
+  uint8_t row1 = row0 + u8g2->tile_buf_height - 1;
+
+  while( p < end )
+  {
+    c = (const u8g2_dl_cmd_t *)p;
+    p += c->size;
+    if ( c->row1 < row0 || c->row0 > row1 )
+      continue;
+    switch( c->op )
+    {
+      case U8G2_DL_FONT:
+	if ( c->u.font.font != NULL )
+	  u8g2_SetFont(u8g2, c->u.font.font);
+	u8g2->font_calc_vref = c->u.font.font_calc_vref;
+	break;
+      case U8G2_DL_STYLE:
+	u8g2_SetDrawColor(u8g2, c->u.style.draw_color);
+	u8g2_SetFontMode(u8g2, c->u.style.is_transparent);
+	break;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+      case U8G2_DL_CLIP:
+	u8g2_SetClipWindow(u8g2, c->u.clip.x0, c->u.clip.y0, c->u.clip.x1, c->u.clip.y1);
+	break;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+      case U8G2_DL_HVLINE:
+	u8g2_dl_draw_hvline(u8g2, c);
+	break;
+      case U8G2_DL_BOX:
+	u8g2_DrawBox(u8g2, c->u.box.x, c->u.box.y, c->u.box.w, c->u.box.h);
+	break;
+      case U8G2_DL_FRAME:
+	u8g2_DrawFrame(u8g2, c->u.box.x, c->u.box.y, c->u.box.w, c->u.box.h);
+	break;
+      case U8G2_DL_RBOX:
+	u8g2_DrawRBox(u8g2, c->u.box.x, c->u.box.y, c->u.box.w, c->u.box.h, c->u.box.r);
+	break;
+      case U8G2_DL_RFRAME:
+	u8g2_DrawRFrame(u8g2, c->u.box.x, c->u.box.y, c->u.box.w, c->u.box.h, c->u.box.r);
+	break;
+      case U8G2_DL_TILE:
+	u8g2_DrawTileBitmap(u8g2, c->u.tile.x, c->u.tile.y, c->u.tile.w, c->u.tile.h, c->u.tile.bitmap);
+	break;
+      case U8G2_DL_STR:
+	u8g2_DrawStr(u8g2, c->u.str.x, c->u.str.y, c->u.str.s);
+	break;
+      case U8G2_DL_UTF8:
+	u8g2_DrawUTF8(u8g2, c->u.str.x, c->u.str.y, c->u.str.s);
+	break;
+      case U8G2_DL_FIXED:
+	u8g2_DrawFixed(u8g2, c->u.fixed.x, c->u.fixed.y, c->u.fixed.v, c->u.fixed.scale, c->u.fixed.frac, c->u.fixed.width, c->u.fixed.flags);
+	break;
+      case U8G2_DL_DIGITS:
+	u8g2_DrawDigits(u8g2, c->u.digits.dc, c->u.digits.x, c->u.digits.y, c->u.digits.s, NULL);
+	break;
+      case U8G2_DL_CLEAR:
+	u8g2_ClearBuffer(u8g2);
+	break;
+#ifdef U8G2_WITH_DRAWN_AREA
+      case U8G2_DL_CLEAR_DRAWN:
+	u8g2_ClearDrawnArea(u8g2);
+	break;
+#endif /* U8G2_WITH_DRAWN_AREA */
+      case U8G2_DL_CLEAR_AREA:
+	u8g2_dl_clear_area(u8g2, c);
+	break;
+    }
+  }
+}
+
+/*
+  Replacement for the u8g2_FirstPage()/u8g2_NextPage() loop: Draw the list into
+  each page and send the page. The draw state of the caller is restored.
+*/
+void u8g2_SendDisplayList(u8g2_t *u8g2, u8g2_dlist_t *dl)
+{
+  const uint8_t *font = u8g2->font;
+  u8g2_font_calc_vref_fnptr font_calc_vref = u8g2->font_calc_vref;
+  uint8_t draw_color = u8g2->draw_color;
+  uint8_t is_transparent = u8g2->font_decode.is_transparent;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  u8g2_uint_t clip_x0 = u8g2->clip_x0;
+  u8g2_uint_t clip_y0 = u8g2->clip_y0;
+  u8g2_uint_t clip_x1 = u8g2->clip_x1;
+  u8g2_uint_t clip_y1 = u8g2->clip_y1;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+
+  u8g2_FirstPage(u8g2);
+  do
+  {
+    u8g2_DrawDisplayList(u8g2, dl);
+  } while( u8g2_NextPage(u8g2) );
+
+  if ( font != NULL )
+    u8g2_SetFont(u8g2, font);
+  u8g2->font_calc_vref = font_calc_vref;
+  u8g2->draw_color = draw_color;
+  u8g2->font_decode.is_transparent = is_transparent;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  u8g2_SetClipWindow(u8g2, clip_x0, clip_y0, clip_x1, clip_y1);
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+}
+
+#endif /* U8G2_WITH_DISPLAY_LIST */
@@ -34,6 +34,7 @@
 */
 
 #include "u8g2.h"
+#include <string.h>
 
 /* size of the font data structure, there is no struct or class... */
 /* this is the size for the new font format */
@@ -595,6 +596,165 @@ static void u8g2_font_setup_decode(u8g2_t *u8g2, const uint8_t *glyph_data)
 }
 
 
+#ifdef U8G2_WITH_FAST_GLYPH
+
+struct _u8g2_fast_glyph_t
+{
+  uint8_t col[U8G2_FAST_GLYPH_MAX_WIDTH];	/* one byte per glyph column for the current buffer page */
+  u8g2_uint_t y;		/* screen row of the local position */
+  uint8_t lx;			/* local position inside the glyph */
+  uint8_t ly;
+  uint8_t bit;			/* bit of row y inside the buffer page */
+  uint8_t rows;		/* visible rows which are collected in col[] */
+  uint8_t is_visible;	/* row y is inside the user window */
+};
+typedef struct _u8g2_fast_glyph_t u8g2_fast_glyph_t;
+
+/*
+  Merge the collected page into the buffer: One read-modify-write per column.
+  Foreground and background pixel are combined with masks for the fg and bg color.
+*/
+static void u8g2_font_fast_glyph_flush(u8g2_t *u8g2, u8g2_fast_glyph_t *f)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  uint8_t *ptr;
+  uint8_t c, fg, bg, v;
+  uint8_t fg_clr, fg_set, fg_xor, bg_clr, bg_set;
+
+  if ( f->rows == 0 )
+    return;
+  
+  fg_clr = decode->fg_color == 0 ? 0x0ff : 0;
+  fg_set = decode->fg_color == 1 ? 0x0ff : 0;
+  fg_xor = decode->fg_color >= 2 ? 0x0ff : 0;
+  bg_clr = 0;
+  bg_set = 0;
+  if ( decode->is_transparent == 0 )
+  {
+    bg_clr = decode->bg_color == 0 ? 0x0ff : 0;
+    bg_set = decode->bg_color != 0 ? 0x0ff : 0;
+  }
+
+  ptr = u8g2->tile_buf_ptr;
+  ptr += (uint32_t)((f->y - u8g2->pixel_curr_row) >> 3) * u8g2->pixel_buf_width;
+  ptr += decode->target_x;
+#ifdef U8G2_WITH_DRAWN_AREA
+  u8g2_mark_drawn_area(u8g2, decode->target_x, (f->y - u8g2->pixel_curr_row) & ~7, decode->glyph_width, 8);
+#endif /* U8G2_WITH_DRAWN_AREA */
+  for( c = 0; c < (uint8_t)decode->glyph_width; c++ )
+  {
+    fg = f->col[c];
+    bg = f->rows & ~fg;
+    v = *ptr;
+    v &= ~((fg & fg_clr) | (bg & bg_clr));
+    v |= (fg & fg_set) | (bg & bg_set);
+    v ^= fg & fg_xor;
+    *ptr++ = v;
+    f->col[c] = 0;
+  }
+  f->rows = 0;
+}
+
+/*
+  Fast version of u8g2_font_decode_len(): The run is written into the column bytes.
+*/
+static void u8g2_font_fast_glyph_len(u8g2_t *u8g2, u8g2_fast_glyph_t *f, uint8_t len, uint8_t is_foreground)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  uint8_t cnt, end;
+  
+  while( len > 0 && f->ly < (uint8_t)decode->glyph_height )
+  {
+    cnt = (uint8_t)decode->glyph_width - f->lx;
+    if ( len < cnt )
+      cnt = len;
+    len -= cnt;
+    end = f->lx + cnt;
+    if ( is_foreground && f->is_visible )
+    {
+      do
+      {
+	f->col[f->lx] |= f->bit;
+	f->lx++;
+      } while( f->lx < end );
+    }
+    f->lx = end;
+    
+    if ( f->lx >= (uint8_t)decode->glyph_width )
+    {
+      /* end of the glyph row */
+      if ( f->is_visible )
+	f->rows |= f->bit;
+      f->ly++;
+      if ( f->bit == 0x080 || f->ly >= (uint8_t)decode->glyph_height )
+	u8g2_font_fast_glyph_flush(u8g2, f);
+      f->lx = 0;
+      f->y++;
+      f->bit <<= 1;
+      if ( f->bit == 0 )
+	f->bit = 1;
+      f->is_visible = f->y >= u8g2->user_y0 && f->y < u8g2->user_y1;
+    }
+  }
+}
+
+/*
+  Decode and draw a glyph directly into a vertical top lsb buffer (SSD1306 and most 
+  other monochrome controller) without rotation and with font direction 0.
+  The glyph must be inside the user window horizontally, rows outside the user window
+  are skipped. This avoids the clipping and the hvline procedure for each run.
+  Returns 0 if the glyph can not be drawn this way, nothing has been decoded in this case.
+*/
+static uint8_t u8g2_font_decode_glyph_fast(u8g2_t *u8g2)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  u8g2_fast_glyph_t f;
+  u8g2_uint_t x1;
+  uint8_t a, b;
+  
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb || u8g2->cb != U8G2_R0 )
+    return 0;
+#ifdef U8G2_WITH_FONT_ROTATION
+  if ( decode->dir != 0 )
+    return 0;
+#endif
+  if ( decode->glyph_width > U8G2_FAST_GLYPH_MAX_WIDTH || decode->glyph_height <= 0 )
+    return 0;
+  x1 = decode->target_x;
+  x1 += decode->glyph_width;
+  if ( decode->target_x < u8g2->user_x0 || x1 > u8g2->user_x1 || x1 < decode->target_x )
+    return 0;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return 0;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+
+  memset(f.col, 0, decode->glyph_width);
+  f.y = decode->target_y;
+  f.lx = 0;
+  f.ly = 0;
+  f.bit = 1 << (f.y & 7);
+  f.rows = 0;
+  f.is_visible = f.y >= u8g2->user_y0 && f.y < u8g2->user_y1;
+  
+  for(;;)
+  {
+    a = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_0);
+    b = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_1);
+    do
+    {
+      u8g2_font_fast_glyph_len(u8g2, &f, a, 0);
+      u8g2_font_fast_glyph_len(u8g2, &f, b, 1);
+    } while( u8g2_font_decode_get_unsigned_bits(decode, 1) != 0 );
+
+    if ( f.ly >= (uint8_t)decode->glyph_height )
+      break;
+  }
+  return 1;
+}
+
+#endif /* U8G2_WITH_FAST_GLYPH */
+
 /*
   Description:
     Decode and draw a glyph.
@@ -683,6 +843,11 @@ int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
 	return d;
     }
 #endif /* U8G2_WITH_INTERSECTION */
+
+#ifdef U8G2_WITH_FAST_GLYPH
+    if ( u8g2_font_decode_glyph_fast(u8g2) != 0 )
+      return d;
+#endif /* U8G2_WITH_FAST_GLYPH */
    
     /* reset local x/y position */
     decode->x = 0;
@@ -771,6 +936,129 @@ int8_t u8g2_font_2x_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
   return d*2;
 }
 
+#ifdef U8G2_WITH_GLYPH_INDEX
+
+/*
+  Description:
+    Build the sparse glyph index for the unicode part of the current font.
+    Called by u8g2_SetFont(), walks all unicode glyphs of the font twice.
+*/
+static void u8g2_font_build_glyph_index(u8g2_t *u8g2)
+{
+  const uint8_t *font;
+  const uint8_t *glyph;
+  uint16_t cnt;
+  uint16_t step;
+  uint16_t i;
+  
+  u8g2->glyph_index_cnt = 0;
+  u8g2->glyph_cache_cnt = 0;
+  if ( u8g2->font == NULL )
+    return;
+  
+  font = u8g2->font;
+  font += U8G2_FONT_DATA_STRUCT_SIZE;
+  font += u8g2->font_info.start_pos_unicode;
+  /* the first entry of the unicode lookup table points to the first glyph */
+  glyph = font + u8g2_font_get_word(font, 0);
+  
+  cnt = 0;
+  for( font = glyph; u8g2_font_get_word(font, 0) != 0; font += u8x8_pgm_read( font + 2 ) )
+    cnt++;
+  
+  step = cnt / U8G2_GLYPH_INDEX_SIZE + 1;
+  i = 0;
+  for( font = glyph; u8g2_font_get_word(font, 0) != 0; font += u8x8_pgm_read( font + 2 ) )
+  {
+    if ( i == 0 )
+    {
+      u8g2->glyph_index_encoding[u8g2->glyph_index_cnt] = u8g2_font_get_word(font, 0);
+      u8g2->glyph_index_data[u8g2->glyph_index_cnt] = font;
+      u8g2->glyph_index_cnt++;
+    }
+    i++;
+    if ( i >= step )
+      i = 0;
+  }
+}
+
+/*
+  Description:
+    Unicode part of u8g2_font_get_glyph_data(): LRU cache, then binary search
+    on the sparse index and a short linear search from the found entry.
+    Glyphs are sorted by encoding, so the search stops at the first larger encoding.
+*/
+static const uint8_t *u8g2_font_get_unicode_glyph_data(u8g2_t *u8g2, uint16_t encoding)
+{
+  const uint8_t *font;
+  uint16_t e;
+  uint8_t lo, hi, mid;
+  uint8_t i;
+  
+  for( i = 0; i < u8g2->glyph_cache_cnt; i++ )
+  {
+    if ( u8g2->glyph_cache_encoding[i] == encoding )
+    {
+      font = u8g2->glyph_cache_data[i];
+      /* move to front */
+      for( ; i > 0; i-- )
+      {
+	u8g2->glyph_cache_encoding[i] = u8g2->glyph_cache_encoding[i-1];
+	u8g2->glyph_cache_data[i] = u8g2->glyph_cache_data[i-1];
+      }
+      u8g2->glyph_cache_encoding[0] = encoding;
+      u8g2->glyph_cache_data[0] = font;
+      return font;
+    }
+  }
+  
+  if ( u8g2->glyph_index_cnt == 0 )
+    return NULL;
+  if ( encoding < u8g2->glyph_index_encoding[0] )
+    return NULL;
+  
+  /* find the last index entry with an encoding less or equal to the requested encoding */
+  lo = 0;
+  hi = u8g2->glyph_index_cnt;
+  while( hi - lo > 1 )
+  {
+    mid = (lo + hi) / 2;
+    if ( u8g2->glyph_index_encoding[mid] <= encoding )
+      lo = mid;
+    else
+      hi = mid;
+  }
+  
+  font = u8g2->glyph_index_data[lo];
+  for(;;)
+  {
+    e = u8g2_font_get_word(font, 0);
+    if ( e == 0 || e > encoding )
+      return NULL;
+    if ( e == encoding )
+      break;
+    font += u8x8_pgm_read( font + 2 );
+  }
+  font += 3;	/* skip encoding and glyph size */
+  
+  /* insert as most recent entry, the oldest entry is dropped */
+  i = u8g2->glyph_cache_cnt;
+  if ( i < U8G2_GLYPH_CACHE_SIZE )
+    u8g2->glyph_cache_cnt++;
+  else
+    i--;
+  for( ; i > 0; i-- )
+  {
+    u8g2->glyph_cache_encoding[i] = u8g2->glyph_cache_encoding[i-1];
+    u8g2->glyph_cache_data[i] = u8g2->glyph_cache_data[i-1];
+  }
+  u8g2->glyph_cache_encoding[0] = encoding;
+  u8g2->glyph_cache_data[0] = font;
+  return font;
+}
+
+#endif /* U8G2_WITH_GLYPH_INDEX */
+
 /*
   Description:
     Find the starting point of the glyph data.
@@ -807,7 +1095,12 @@ const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding)
       font += u8x8_pgm_read( font + 1 );
     }
   }
-#ifdef U8G2_WITH_UNICODE
+#ifdef U8G2_WITH_GLYPH_INDEX
+  else
+  {
+    return u8g2_font_get_unicode_glyph_data(u8g2, encoding);
+  }
+#elif defined(U8G2_WITH_UNICODE)
   else
   {
     uint16_t e;
@@ -1039,6 +1332,10 @@ static u8g2_uint_t u8g2_draw_string_2x(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t
 u8g2_uint_t u8g2_DrawStr(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char *str)
 {
   u8g2->u8x8.next_cb = u8x8_ascii_next;
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dlist != NULL )
+    return u8g2_dl_str(u8g2, U8G2_DL_STR, x, y, str);
+#endif /* U8G2_WITH_DISPLAY_LIST */
   return u8g2_draw_string(u8g2, x, y, str);
 }
 
@@ -1061,6 +1358,10 @@ Bits	from 		to			bytes	Byte 1 		Byte 2 		Byte 3 		Byte 4 		Byte 5 		Byte 6
 u8g2_uint_t u8g2_DrawUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char *str)
 {
   u8g2->u8x8.next_cb = u8x8_utf8_next;
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dlist != NULL )
+    return u8g2_dl_str(u8g2, U8G2_DL_UTF8, x, y, str);
+#endif /* U8G2_WITH_DISPLAY_LIST */
   return u8g2_draw_string(u8g2, x, y, str);
 }
 
@@ -1286,6 +1587,9 @@ void u8g2_SetFont(u8g2_t *u8g2, const uint8_t  *font)
 //#endif 
     u8g2->font = font;
     u8g2_read_font_info(&(u8g2->font_info), font);
+#ifdef U8G2_WITH_GLYPH_INDEX
+    u8g2_font_build_glyph_index(u8g2);
+#endif
     u8g2_UpdateRefHeight(u8g2);
     /* u8g2_SetFontPosBaseline(u8g2); */ /* removed with issue 195 */
   }
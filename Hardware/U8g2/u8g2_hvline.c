@@ -137,6 +137,13 @@ void u8g2_draw_hv_line_2dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uin
   /* transform to pixel buffer coordinates */
   y -= u8g2->pixel_curr_row;
   
+#ifdef U8G2_WITH_DRAWN_AREA
+  if ( dir == 0 )
+    u8g2_mark_drawn_area(u8g2, x, y, len, 1);
+  else
+    u8g2_mark_drawn_area(u8g2, x, y, 1, len);
+#endif /* U8G2_WITH_DRAWN_AREA */
+  
   u8g2->ll_hvline(u8g2, x, y, len, dir);
 }
 
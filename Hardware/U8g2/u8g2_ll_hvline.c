@@ -59,6 +59,87 @@
 */
 
 
+#ifdef U8G2_WITH_FAST_FILL
+
+#if defined(__GNUC__)
+typedef uint32_t u8g2_fill_word_t __attribute__((__may_alias__));
+#else
+typedef uint32_t u8g2_fill_word_t;
+#endif
+
+/*
+  Apply or_mask and xor_mask to w bytes of one page.
+  The bytes between the 32 bit boundaries are processed as words.
+*/
+static void u8g2_fill_page_row(uint8_t *ptr, u8g2_uint_t w, uint8_t or_mask, uint8_t xor_mask)
+{
+  uint32_t or_word, xor_word;
+  u8g2_fill_word_t *wptr;
+  
+  while( w != 0 && ((size_t)ptr & 3) != 0 )
+  {
+    *ptr |= or_mask;
+    *ptr ^= xor_mask;
+    ptr++;
+    w--;
+  }
+  
+  or_word = or_mask * 0x01010101UL;
+  xor_word = xor_mask * 0x01010101UL;
+  wptr = (u8g2_fill_word_t *)ptr;
+  while( w >= 4 )
+  {
+    *wptr = (*wptr | or_word) ^ xor_word;
+    wptr++;
+    w -= 4;
+  }
+  
+  ptr = (uint8_t *)wptr;
+  while( w != 0 )
+  {
+    *ptr |= or_mask;
+    *ptr ^= xor_mask;
+    ptr++;
+    w--;
+  }
+}
+
+/*
+  x,y		Upper left position of the rectangle within the local buffer (not the display!)
+  w,h		size of the rectangle, may be 0
+  color		0: clear, 1: set, 2: xor (same as draw_color)
+  asumption: 
+    all clipping done
+*/
+void u8g2_ll_fill_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t color)
+{
+  uint8_t *ptr;
+  uint8_t bit_pos, rows, mask;
+  
+  if ( w == 0 )
+    return;
+  
+  ptr = u8g2->tile_buf_ptr;
+  ptr += (uint32_t)(y >> 3) * u8g2->pixel_buf_width;
+  ptr += x;
+  bit_pos = y & 7;
+  while( h != 0 )
+  {
+    /* rows of this page: all 8 rows, except for the first and the last page */
+    rows = 8 - bit_pos;
+    if ( h < rows )
+      rows = h;
+    mask = 0x0ff >> (8 - rows);
+    mask <<= bit_pos;
+    u8g2_fill_page_row(ptr, w, color <= 1 ? mask : 0, color != 1 ? mask : 0);
+    h -= rows;
+    bit_pos = 0;
+    ptr += u8g2->pixel_buf_width;
+  }
+}
+
+#endif /* U8G2_WITH_FAST_FILL */
+
 #ifdef U8G2_WITH_HVLINE_SPEED_OPTIMIZATION
 
 /*
@@ -84,6 +165,20 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
   //assert(y >= u8g2->buf_y0);
   //assert(y < u8g2_GetU8x8(u8g2)->display_info->tile_height*8);
   
+#ifdef U8G2_WITH_FAST_FILL
+  /* vertical lines: one access per page, long horizontal lines: 32 bit access */
+  if ( dir != 0 )
+  {
+    u8g2_ll_fill_vertical_top_lsb(u8g2, x, y, 1, len, u8g2->draw_color);
+    return;
+  }
+  if ( len >= 8 )
+  {
+    u8g2_ll_fill_vertical_top_lsb(u8g2, x, y, len, 1, u8g2->draw_color);
+    return;
+  }
+#endif /* U8G2_WITH_FAST_FILL */
+  
   /* bytes are vertical, lsb on top (y=0), msb at bottom (y=7) */
   bit_pos = y;		/* overflow truncate is ok here... */
   bit_pos &= 7; 	/* ... because only the lowest 3 bits are needed */
@@ -0,0 +1,322 @@
+/*
+
+  u8g2_number.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Numbers without sprintf: The value is converted with u8x8_fixtoap()
+  (integer only, no division) and the glyphs are drawn directly from
+  the glyph data pointers which are kept for "0123456789 +-.".
+
+  u8g2_DrawNumber(u8g2, x, y, v, 4, 0)		same as "%4d"
+  u8g2_DrawFixed(u8g2, x, y, uA, 3, 2, 6, 0)	uA as mA, same as "%6.2f"
+
+  Digit cache: The chars of u8x8_fixtoap() and some unit letters are
+  rendered once per font into cells in tile format. u8g2_DrawDigits() 
+  copies the cells with u8g2_DrawTileBitmap(), a whole byte per column
+  if the upper edge of the font bbx is on a page boundary. With the 
+  string which is already in the buffer, only the chars which have 
+  changed are cleared and copied again:
+
+  u8g2_DrawNumberDigits(u8g2, &dc, x, y, v, NULL, 4, 0)	draw all digits
+  u8g2_DrawNumberDigits(u8g2, &dc, x, y, v, &old, 4, 0)	redraw the digits which differ from old
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+static const char u8g2_number_glyphs[U8G2_NUMBER_GLYPH_CNT] = "0123456789 +-.";
+
+#ifdef U8G2_WITH_NUMBER_GLYPHS
+
+/* glyph data of one of the chars from u8x8_fixtoap() */
+static const uint8_t *u8g2_number_glyph_data(u8g2_t *u8g2, char c)
+{
+  uint8_t i;
+  
+  if ( u8g2->number_glyph_font != u8g2->font )
+  {
+    for( i = 0; i < U8G2_NUMBER_GLYPH_CNT; i++ )
+      u8g2->number_glyph_data[i] = u8g2_font_get_glyph_data(u8g2, (uint8_t)u8g2_number_glyphs[i]);
+    u8g2->number_glyph_font = u8g2->font;
+  }
+  
+  if ( c >= '0' && c <= '9' )
+    return u8g2->number_glyph_data[c - '0'];
+  for( i = 10; i < U8G2_NUMBER_GLYPH_CNT; i++ )
+    if ( u8g2_number_glyphs[i] == c )
+      return u8g2->number_glyph_data[i];
+  return NULL;
+}
+
+#endif /* U8G2_WITH_NUMBER_GLYPHS */
+
+/*
+  Draw a fixed point number, see u8x8_fixtoap() for the arguments.
+  Returns the width of the drawn number (sum of the glyph delta x values) 
+  like u8g2_DrawStr().
+*/
+u8g2_uint_t u8g2_DrawFixed(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, int32_t v, uint8_t scale, uint8_t frac, uint8_t width, uint8_t flags)
+{
+  char buf[U8X8_FIX_SIZE];
+#ifdef U8G2_WITH_NUMBER_GLYPHS
+  const uint8_t *glyph_data;
+  const char *s;
+  u8g2_uint_t dx, sum;
+#endif /* U8G2_WITH_NUMBER_GLYPHS */
+  
+  if ( u8g2->font == NULL )
+    return 0;
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dlist != NULL )
+    return u8g2_dl_fixed(u8g2, x, y, v, scale, frac, width, flags);
+#endif /* U8G2_WITH_DISPLAY_LIST */
+  u8x8_fixtoap(buf, v, scale, frac, width, flags);
+  
+#ifdef U8G2_WITH_NUMBER_GLYPHS
+#ifdef U8G2_WITH_FONT_ROTATION
+  if ( u8g2->font_decode.dir == 0 )
+#endif
+  {
+    y += u8g2->font_calc_vref(u8g2);
+    sum = 0;
+    for( s = buf; *s != '\0'; s++ )
+    {
+      glyph_data = u8g2_number_glyph_data(u8g2, *s);
+      if ( glyph_data != NULL )
+      {
+	u8g2->font_decode.target_x = x;
+	u8g2->font_decode.target_y = y;
+	dx = u8g2_font_decode_glyph(u8g2, glyph_data);
+	x += dx;
+	sum += dx;
+      }
+    }
+    return sum;
+  }
+#endif /* U8G2_WITH_NUMBER_GLYPHS */
+  return u8g2_DrawStr(u8g2, x, y, buf);
+}
+
+/*==========================================*/
+/* digit cache */
+
+#define U8G2_DIGIT_MAX (U8X8_FIX_SIZE-1)
+
+/*
+  buf		memory for the cells, 1 + (left + advance) * ((max_char_height+7)/8) 
+		bytes per char. Chars which do not fit are drawn with u8g2_DrawGlyph().
+  units		additional chars, e.g. "mAV", NULL for none
+*/
+void u8g2_InitDigitCache(u8g2_digit_cache_t *dc, uint8_t *buf, uint16_t buf_size, const char *units)
+{
+  dc->buf = buf;
+  dc->buf_size = buf_size;
+  dc->units = units;
+  dc->font = NULL;
+}
+
+/* size of one cell: advance and bitmap */
+static uint16_t u8g2_digit_cell_size(u8g2_digit_cache_t *dc)
+{
+  return 1 + (uint16_t)(dc->left + dc->advance) * ((dc->height + 7) >> 3);
+}
+
+static char u8g2_digit_char(u8g2_digit_cache_t *dc, uint8_t i)
+{
+  if ( i < U8G2_NUMBER_GLYPH_CNT )
+    return u8g2_number_glyphs[i];
+  if ( dc->units == NULL )
+    return '\0';
+  return dc->units[i - U8G2_NUMBER_GLYPH_CNT];
+}
+
+static void u8g2_digit_cache_render(u8g2_t *u8g2, u8g2_digit_cache_t *dc)
+{
+  char s[2];
+  uint16_t size;
+  uint8_t i, dx;
+  uint8_t *cell;
+
+  dc->font = u8g2->font;
+  dc->height = u8g2->font_info.max_char_height;
+  dc->left = 0;
+  if ( u8g2->font_info.x_offset < 0 )
+    dc->left = -u8g2->font_info.x_offset;
+  dc->advance = 0;
+  for( i = 0; u8g2_digit_char(dc, i) != '\0'; i++ )
+  {
+    dx = u8g2_GetGlyphWidth(u8g2, (uint8_t)u8g2_digit_char(dc, i));
+    if ( dc->advance < dx )
+      dc->advance = dx;
+  }
+  
+  size = u8g2_digit_cell_size(dc);
+  s[1] = '\0';
+  for( i = 0; (uint16_t)(i + 1) * size <= dc->buf_size; i++ )
+  {
+    s[0] = u8g2_digit_char(dc, i);
+    if ( s[0] == '\0' )
+      break;
+    cell = dc->buf + i * size;
+    memset(cell, 0, size);
+    cell[0] = u8g2_render_tiles(u8g2, cell + 1, dc->left + dc->advance, dc->height, dc->left, s);
+  }
+  dc->cnt = i;
+}
+
+/* cell of c, dc->cnt if c has not been rendered */
+static uint8_t u8g2_digit_cell(u8g2_digit_cache_t *dc, char c)
+{
+  uint8_t i;
+  
+  if ( c >= '0' && c <= '9' )
+    i = c - '0';
+  else
+    for( i = 10; i < dc->cnt; i++ )
+      if ( u8g2_digit_char(dc, i) == c )
+	break;
+  return i < dc->cnt ? i : dc->cnt;
+}
+
+/* cells and x positions (relative to the reference position) of the chars of str, pos[n] is the width */
+static uint8_t u8g2_digit_layout(u8g2_t *u8g2, u8g2_digit_cache_t *dc, const char *str, uint8_t *cell, u8g2_uint_t *pos)
+{
+  uint16_t size = u8g2_digit_cell_size(dc);
+  u8g2_uint_t x = 0;
+  uint8_t i;
+  
+  for( i = 0; str[i] != '\0' && i < U8G2_DIGIT_MAX; i++ )
+  {
+    pos[i] = x;
+    cell[i] = u8g2_digit_cell(dc, str[i]);
+    if ( cell[i] < dc->cnt )
+      x += dc->buf[cell[i] * size];
+    else
+      x += u8g2_GetGlyphWidth(u8g2, (uint8_t)str[i]);
+  }
+  pos[i] = x;
+  return i;
+}
+
+/*
+  Draw str at the reference position x/y like u8g2_DrawStr().
+  old == NULL: All chars are drawn, only the foreground pixels are set.
+  old != NULL: old is the string which has been drawn at this position before.
+	Only the cells of old which differ from str (other char or other x 
+	position) are cleared. The changed cells of str and the cells which 
+	overlap a cleared cell are drawn again.
+  Returns the width of str (sum of the glyph delta x values). Font directions
+  other than 0 are passed to u8g2_DrawUTF8() without clearing the old string.
+  While a display list is recorded, old == NULL is recorded as one command
+  which draws the same cells during the replay: The cache must not be rendered
+  again for another font until the list has been sent.
+*/
+u8g2_uint_t u8g2_DrawDigits(u8g2_t *u8g2, u8g2_digit_cache_t *dc, u8g2_uint_t x, u8g2_uint_t y, const char *str, const char *old)
+{
+  uint8_t cell[U8G2_DIGIT_MAX], old_cell[U8G2_DIGIT_MAX];
+  u8g2_uint_t pos[U8G2_DIGIT_MAX+1], old_pos[U8G2_DIGIT_MAX+1];
+  uint32_t cleared, redraw;
+  uint16_t size;
+  u8g2_uint_t top, w, cx, cw;
+  uint8_t i, k, n, old_n, is_transparent;
+
+  if ( u8g2->font == NULL )
+    return 0;
+#ifdef U8G2_WITH_FONT_ROTATION
+  if ( u8g2->font_decode.dir != 0 )
+    return u8g2_DrawUTF8(u8g2, x, y, str);
+#endif
+  if ( dc->font != u8g2->font )
+    u8g2_digit_cache_render(u8g2, dc);
+
+  n = u8g2_digit_layout(u8g2, dc, str, cell, pos);
+#ifdef U8G2_WITH_DISPLAY_LIST
+  /* one command instead of one bitmap command per cell */
+  if ( u8g2->dlist != NULL && old == NULL )
+  {
+    u8g2_dl_digits(u8g2, dc, x, y, str);
+    return pos[n];
+  }
+#endif /* U8G2_WITH_DISPLAY_LIST */
+  w = dc->left + dc->advance;
+  redraw = ~(uint32_t)0;
+  if ( old != NULL )
+  {
+    old_n = u8g2_digit_layout(u8g2, dc, old, old_cell, old_pos);
+    cleared = 0;
+    for( i = 0; i < old_n; i++ )
+      if ( i >= n || old[i] != str[i] || old_pos[i] != pos[i] )
+	cleared |= (uint32_t)1 << i;
+    
+    /* cells of str which are new or overlap a cleared cell of old */
+    redraw = 0;
+    for( i = 0; i < n; i++ )
+    {
+      if ( i >= old_n || (cleared & ((uint32_t)1 << i)) )
+      {
+	redraw |= (uint32_t)1 << i;
+	continue;
+      }
+      for( k = 0; k < old_n; k++ )
+	if ( (cleared & ((uint32_t)1 << k)) && pos[i] < old_pos[k] + w && old_pos[k] < pos[i] + w )
+	  redraw |= (uint32_t)1 << i;
+    }
+    
+    /* clear each run of cleared cells with one call */
+    top = y + u8g2->font_calc_vref(u8g2);
+    top -= u8g2->font_info.max_char_height + u8g2->font_info.y_offset;
+    for( i = 0; i < old_n; i++ )
+    {
+      if ( (cleared & ((uint32_t)1 << i)) == 0 )
+	continue;
+      for( k = i; k + 1 < old_n && (cleared & ((uint32_t)1 << (k + 1))); k++ )
+	;
+      cx = x + old_pos[i] - dc->left;
+      cw = old_pos[k] - old_pos[i] + w;
+      if ( (u8g2_uint_t)(cx + cw) < cx )	/* starts left of the display */
+      {
+	cw = cx + cw;
+	cx = 0;
+      }
+      u8g2_ClearBufferArea(u8g2, cx, top, cw, dc->height);
+      i = k;
+    }
+  }
+  
+  top = y + u8g2->font_calc_vref(u8g2);
+  top -= u8g2->font_info.max_char_height + u8g2->font_info.y_offset;
+  size = u8g2_digit_cell_size(dc);
+  /* chars without a cell: like the cells, the glyph background must not clear the neighbour cells */
+  is_transparent = u8g2->font_decode.is_transparent;
+  u8g2->font_decode.is_transparent = 1;
+  for( i = 0; i < n; i++ )
+  {
+    if ( (redraw & ((uint32_t)1 << i)) == 0 )
+      continue;
+    if ( cell[i] < dc->cnt )
+      u8g2_DrawTileBitmap(u8g2, x + pos[i] - dc->left, top, w, dc->height, dc->buf + cell[i] * size + 1);
+    else
+      u8g2_DrawGlyph(u8g2, x + pos[i], y, (uint8_t)str[i]);
+  }
+  u8g2->font_decode.is_transparent = is_transparent;
+  return pos[n];
+}
+
+/*
+  Draw v like u8g2_DrawFixed() with the digit cache. If old is not NULL, 
+  *old is the value which has been drawn at this position with the same
+  arguments before, only the chars which are different are drawn again.
+*/
+u8g2_uint_t u8g2_DrawFixedDigits(u8g2_t *u8g2, u8g2_digit_cache_t *dc, u8g2_uint_t x, u8g2_uint_t y, int32_t v, const int32_t *old, uint8_t scale, uint8_t frac, uint8_t width, uint8_t flags)
+{
+  char buf[U8X8_FIX_SIZE];
+  char prev[U8X8_FIX_SIZE];
+  
+  u8x8_fixtoap(buf, v, scale, frac, width, flags);
+  if ( old == NULL )
+    return u8g2_DrawDigits(u8g2, dc, x, y, buf, NULL);
+  u8x8_fixtoap(prev, *old, scale, frac, width, flags);
+  return u8g2_DrawDigits(u8g2, dc, x, y, buf, prev);
+}
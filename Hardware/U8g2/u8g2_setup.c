@@ -89,6 +89,28 @@ void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_
   u8g2->draw_color = 1;
   u8g2->is_auto_page_clear = 1;
   
+#ifdef U8G2_WITH_DIRTY_TILES
+  u8g2->shadow_buf_ptr = NULL;
+  u8g2->is_shadow_valid = 0;
+#endif /* U8G2_WITH_DIRTY_TILES */
+  
+#ifdef U8G2_WITH_GLYPH_INDEX
+  u8g2->glyph_index_cnt = 0;
+  u8g2->glyph_cache_cnt = 0;
+#endif /* U8G2_WITH_GLYPH_INDEX */
+
+#ifdef U8G2_WITH_NUMBER_GLYPHS
+  u8g2->number_glyph_font = NULL;
+#endif /* U8G2_WITH_NUMBER_GLYPHS */
+
+#ifdef U8G2_WITH_DRAWN_AREA
+  u8g2_InvalidateDrawnArea(u8g2);
+#endif /* U8G2_WITH_DRAWN_AREA */
+
+#ifdef U8G2_WITH_DISPLAY_LIST
+  u8g2->dlist = NULL;
+#endif /* U8G2_WITH_DISPLAY_LIST */
+  
   u8g2->cb = u8g2_cb;
   u8g2->cb->update_dimension(u8g2);
 #ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
@@ -0,0 +1,184 @@
+/*
+
+  u8g2_text_cache.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Retained text: A string is rendered once into a bitmap in tile format
+  and copied with u8g2_DrawTileBitmap() on later calls. This avoids the
+  utf8 decode, glyph search and glyph decode for static labels.
+
+  The bitmap is rendered again if the font or the string pointer changes.
+  The content of the string is not compared: Use u8g2_InvalidateTextCache()
+  if the string is modified in place (e.g. by sprintf).
+
+  Only the foreground pixels are drawn (like u8g2_SetFontMode(u8g2, 1)).
+  With draw color 2, pixels where two glyphs overlap are inverted only once.
+  Font directions other than 0 are passed to u8g2_DrawUTF8().
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+static uint8_t *u8g2_render_tiles_buf;
+static u8g2_uint_t u8g2_render_tiles_width;
+
+/*
+  ll_hvline procedure while rendering into a tile bitmap.
+  x and y are already clipped to the size of the bitmap.
+*/
+static void u8g2_render_tiles_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  (void)u8g2;
+  do
+  {
+    u8g2_render_tiles_buf[(y>>3)*u8g2_render_tiles_width + x] |= 1<<(y&7);
+    if ( dir == 0 )
+      x++;
+    else
+      y++;
+    len--;
+  } while( len != 0 );
+}
+
+/*
+  Draw str into buf (tile format, w x h pixel, cleared by the caller) instead
+  of the frame buffer. The upper edge of the font bbx is placed at y=0 of the
+  bitmap, the reference position of the string is x. Only the foreground pixels
+  are set. Returns the advance of u8g2_DrawUTF8(). Also used for the digit 
+  cells in u8g2_number.c.
+*/
+u8g2_uint_t u8g2_render_tiles(u8g2_t *u8g2, uint8_t *buf, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t x, const char *str)
+{
+  u8g2_draw_ll_hvline_cb ll_hvline = u8g2->ll_hvline;
+  const u8g2_cb_t *cb = u8g2->cb;
+  u8g2_uint_t pixel_curr_row = u8g2->pixel_curr_row;
+  u8g2_uint_t user_x0 = u8g2->user_x0;
+  u8g2_uint_t user_x1 = u8g2->user_x1;
+  u8g2_uint_t user_y0 = u8g2->user_y0;
+  u8g2_uint_t user_y1 = u8g2->user_y1;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  uint8_t is_page_clip_window_intersection = u8g2->is_page_clip_window_intersection;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  uint8_t draw_color = u8g2->draw_color;
+  uint8_t is_transparent = u8g2->font_decode.is_transparent;
+#ifdef U8G2_WITH_DRAWN_AREA
+  u8g2_area_t drawn_area = u8g2->drawn_area;	/* the bitmap is not part of the buffer */
+#endif /* U8G2_WITH_DRAWN_AREA */
+#ifdef U8G2_WITH_DISPLAY_LIST
+  u8g2_dlist_t *dlist = u8g2->dlist;		/* the string is rendered now, only the bitmap is recorded */
+#endif /* U8G2_WITH_DISPLAY_LIST */
+  u8g2_uint_t ascent;
+  u8g2_uint_t advance;
+
+  /* the user window is the bitmap, no rotation, no page offset */
+  u8g2_render_tiles_buf = buf;
+  u8g2_render_tiles_width = w;
+  u8g2->ll_hvline = u8g2_render_tiles_hvline;
+  u8g2->cb = U8G2_R0;
+  u8g2->pixel_curr_row = 0;
+  u8g2->user_x0 = 0;
+  u8g2->user_x1 = w;
+  u8g2->user_y0 = 0;
+  u8g2->user_y1 = h;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  u8g2->is_page_clip_window_intersection = 1;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  u8g2->draw_color = 1;
+  u8g2->font_decode.is_transparent = 1;
+#ifdef U8G2_WITH_DISPLAY_LIST
+  u8g2->dlist = NULL;
+#endif /* U8G2_WITH_DISPLAY_LIST */
+
+  ascent = u8g2->font_info.max_char_height;
+  ascent += u8g2->font_info.y_offset;
+  advance = u8g2_DrawUTF8(u8g2, x, ascent - u8g2->font_calc_vref(u8g2), str);
+
+  u8g2->ll_hvline = ll_hvline;
+  u8g2->cb = cb;
+  u8g2->pixel_curr_row = pixel_curr_row;
+  u8g2->user_x0 = user_x0;
+  u8g2->user_x1 = user_x1;
+  u8g2->user_y0 = user_y0;
+  u8g2->user_y1 = user_y1;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  u8g2->is_page_clip_window_intersection = is_page_clip_window_intersection;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  u8g2->draw_color = draw_color;
+  u8g2->font_decode.is_transparent = is_transparent;
+#ifdef U8G2_WITH_DRAWN_AREA
+  u8g2->drawn_area = drawn_area;
+#endif /* U8G2_WITH_DRAWN_AREA */
+#ifdef U8G2_WITH_DISPLAY_LIST
+  u8g2->dlist = dlist;
+#endif /* U8G2_WITH_DISPLAY_LIST */
+  u8g2_render_tiles_buf = NULL;
+  return advance;
+}
+
+static void u8g2_text_cache_render(u8g2_t *u8g2, u8g2_text_cache_t *tc, const char *str)
+{
+  u8g2_uint_t pages;
+
+  tc->font = u8g2->font;
+  tc->str = str;
+  tc->height = u8g2->font_info.max_char_height;
+  pages = (tc->height + 7) >> 3;
+  tc->left = 0;
+  if ( u8g2->font_info.x_offset < 0 )
+    tc->left = -u8g2->font_info.x_offset;
+  tc->width = tc->left;
+  tc->width += u8g2_GetUTF8Width(u8g2, str);
+  if ( (uint32_t)tc->width * pages > tc->buf_size )
+    tc->width = tc->buf_size / pages;
+  memset(tc->buf, 0, tc->width * pages);
+
+  tc->advance = 0;
+  if ( tc->width != 0 )
+    tc->advance = u8g2_render_tiles(u8g2, tc->buf, tc->width, tc->height, tc->left, str);
+}
+
+/*
+  buf		memory for the bitmap, ((max_char_height+7)/8)*string_width bytes.
+		Strings which do not fit are clipped on the right side.
+*/
+void u8g2_InitTextCache(u8g2_text_cache_t *tc, uint8_t *buf, uint16_t buf_size)
+{
+  tc->buf = buf;
+  tc->buf_size = buf_size;
+  u8g2_InvalidateTextCache(tc);
+}
+
+void u8g2_InvalidateTextCache(u8g2_text_cache_t *tc)
+{
+  tc->font = NULL;
+  tc->str = NULL;
+}
+
+/*
+  Same as u8g2_DrawUTF8(), but the string is taken from the cache if
+  font and string pointer are the same as for the previous call.
+*/
+u8g2_uint_t u8g2_DrawUTF8Cached(u8g2_t *u8g2, u8g2_text_cache_t *tc, u8g2_uint_t x, u8g2_uint_t y, const char *str)
+{
+  u8g2_uint_t ascent;
+
+  if ( u8g2->font == NULL )
+    return 0;
+#ifdef U8G2_WITH_FONT_ROTATION
+  if ( u8g2->font_decode.dir != 0 )
+    return u8g2_DrawUTF8(u8g2, x, y, str);
+#endif
+
+  if ( tc->font != u8g2->font || tc->str != str )
+    u8g2_text_cache_render(u8g2, tc, str);
+
+  ascent = u8g2->font_info.max_char_height;
+  ascent += u8g2->font_info.y_offset;
+  y += u8g2->font_calc_vref(u8g2);
+  y -= ascent;
+  x -= tc->left;
+  u8g2_DrawTileBitmap(u8g2, x, y, tc->width, tc->height, tc->buf);
+  return tc->advance;
+}
@@ -351,6 +351,7 @@ struct u8x8_struct
   const uint8_t *font;
   uint16_t encoding;		/* encoding result for utf8 decoder in next_cb */
   uint8_t x_offset;	/* copied from info struct, can be modified in flip mode */
+  uint8_t start_line;	/* RAM row shown at the top of the display, see u8x8_SetDisplayStartLine() */
   uint8_t is_font_inverse_mode; 	/* 0: normal, 1: font glyphs are inverted */
   uint8_t i2c_address;	/* a valid i2c adr. Initially this is 255, but this is set to something useful during DISPLAY_INIT */
 					/* i2c_address is the address for writing data to the display */
@@ -533,6 +534,23 @@ void u8x8_d_helper_display_init(u8x8_t *u8g2);
 */
 #define U8X8_MSG_DISPLAY_REFRESH 16
 
+/*
+  Name: 	U8X8_MSG_DISPLAY_SET_START_LINE
+  Args:	
+    arg_int: RAM row which is shown at the top of the display
+    arg_ptr: -
+  
+  Vertical hardware scroll: The display shows RAM row (y + arg_int) modulo 
+  the RAM height at row y. The RAM content and the RAM addressing of 
+  U8X8_MSG_DISPLAY_DRAW_TILE are not changed, so content which is already
+  in the RAM moves with a single command.
+  Must return 0 if the controller does not support this.
+  Use
+    uint8_t u8x8_SetDisplayStartLine(u8x8_t *u8x8, uint8_t line)
+  to send the message to the display handler.
+*/
+#define U8X8_MSG_DISPLAY_SET_START_LINE 17
+
 /*==========================================*/
 /* u8x8_setup.c */
 
@@ -583,6 +601,7 @@ void u8x8_ClearDisplayWithTile(u8x8_t *u8x8, const uint8_t *buf)  U8X8_NOINLINE;
 void u8x8_ClearDisplay(u8x8_t *u8x8);	// this does not work for u8g2 in some cases
 void u8x8_FillDisplay(u8x8_t *u8x8);
 void u8x8_RefreshDisplay(u8x8_t *u8x8);	// make RAM content visible on the display (Dec 16: SSD1606 only)
+uint8_t u8x8_SetDisplayStartLine(u8x8_t *u8x8, uint8_t line);	// vertical hardware scroll, returns 0 if not supported
 void u8x8_ClearLine(u8x8_t *u8x8, uint8_t line);
 
 
@@ -1095,6 +1114,13 @@ const char *u8x8_s8toa(int8_t v, uint8_t d);
 const char *u8x8_u16toa(uint16_t v, uint8_t d);
 const char *u8x8_utoa(uint16_t v);
 
+/* flags for u8x8_fixtoap() */
+#define U8X8_FIX_ZERO 0x01	/* pad with '0' after the sign instead of ' ' before the sign */
+#define U8X8_FIX_PLUS 0x02	/* '+' for values greater or equal to zero */
+#define U8X8_FIX_LEFT 0x04	/* left aligned: pad with ' ' on the right side */
+#define U8X8_FIX_SIZE 24	/* size of the destination buffer for u8x8_fixtoap() */
+uint8_t u8x8_fixtoap(char *dest, int32_t v, uint8_t scale, uint8_t frac, uint8_t width, uint8_t flags);
+
 
 /*==========================================*/
 /* u8x8_string.c */
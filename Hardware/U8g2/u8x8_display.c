@@ -135,6 +135,7 @@ void u8x8_InitInterface(u8x8_t *u8x8)
 void u8x8_InitDisplay(u8x8_t *u8x8)
 {
   u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_INIT, 0, NULL);       /* this will call u8x8_d_helper_display_init() and send the init seqence to the display */
+  u8x8->start_line = 0;		/* the init sequences set the start line to 0 */
   /* u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_SET_FLIP_MODE, 0, NULL);  */ /* It would make sense to call flip mode 0 here after U8X8_MSG_DISPLAY_INIT */
 }
 
@@ -158,6 +159,19 @@ void u8x8_RefreshDisplay(u8x8_t *u8x8)
   u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_REFRESH, 0, NULL);  
 }
 
+/*
+  Show RAM row "line" at the top of the display. Content moves up by "line"
+  rows without any data transfer, rows which leave the top appear at the bottom.
+  Returns 0 if the display does not support this, start_line is not changed then.
+*/
+uint8_t u8x8_SetDisplayStartLine(u8x8_t *u8x8, uint8_t line)
+{
+  if ( u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_SET_START_LINE, line, NULL) == 0 )
+    return 0;
+  u8x8->start_line = line;
+  return 1;
+}
+
 void u8x8_ClearDisplayWithTile(u8x8_t *u8x8, const uint8_t *buf)
 {
   u8x8_tile_t tile;
@@ -74,4 +74,104 @@ const char *u8x8_utoa(uint16_t v)
   if ( *s == '\0' )
     s--;
   return s;
-}
\ No newline at end of file
+}
+
+static const uint32_t u8x8_pow10[10] = 
+{
+  1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 
+  10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+/*
+  Fixed point number to string, without division (no hardware divider on 
+  Cortex-M0) and without floating point.
+  
+  v		value, scaled by 10^scale, e.g. 12345 uA with scale 3 is 12.345 mA
+  scale	number of decimal places in v (0..9)
+  frac	number of decimal places in the output (0..9), rounded half away 
+		from zero if less than scale, filled with '0' if more than scale
+  width	minimum number of chars, padded according to flags (max U8X8_FIX_SIZE-1)
+  flags	U8X8_FIX_ZERO, U8X8_FIX_PLUS, U8X8_FIX_LEFT
+  dest	U8X8_FIX_SIZE bytes
+  
+  Returns the number of chars (without the terminating '\0').
+  Same as sprintf(dest, "%*.*f", width, frac, v/10^scale) for flags = 0,
+  except that a value which is rounded to zero is shown without '-'.
+*/
+uint8_t u8x8_fixtoap(char *dest, int32_t v, uint8_t scale, uint8_t frac, uint8_t width, uint8_t flags)
+{
+  char digits[10];
+  uint32_t u;
+  uint8_t i, pos, len, first, point;
+  char sign, d;
+  
+  if ( scale > 9 )
+    scale = 9;
+  if ( frac > 9 )
+    frac = 9;
+  if ( width > U8X8_FIX_SIZE-1 )
+    width = U8X8_FIX_SIZE-1;
+  
+  u = (uint32_t)v;
+  if ( v < 0 )
+    u = -u;
+  /* rounding: add 0.5 of the last visible place, at most 2^31 + 5*10^8, no overflow */
+  if ( frac < scale )
+    u += u8x8_pow10[9-(scale-frac-1)] * 5;
+  
+  /* same as u8x8_u16toap(), ten digits, most significant first */
+  sign = 0;
+  for( i = 0; i < 10; i++ )
+  {
+    d = '0';
+    while( u >= u8x8_pow10[i] )
+    {
+      u -= u8x8_pow10[i];
+      d++;
+    }
+    digits[i] = d;
+    /* only digits which are visible after rounding decide about the sign */
+    if ( d != '0' && i < 10-scale+frac )
+      sign = '-';
+  }
+  if ( v >= 0 || sign == 0 )
+  {
+    sign = 0;
+    if ( flags & U8X8_FIX_PLUS )
+      sign = '+';
+  }
+  
+  /* the integer part has digits[first..point-1], at least one digit */
+  point = 10-scale;
+  first = 0;
+  while( first < point-1 && digits[first] == '0' )
+    first++;
+  
+  len = point - first;
+  if ( frac != 0 )
+    len += frac + 1;
+  if ( sign != 0 )
+    len++;
+  
+  pos = 0;
+  if ( (flags & (U8X8_FIX_LEFT|U8X8_FIX_ZERO)) == 0 )
+    while( len + pos < width )
+      dest[pos++] = ' ';
+  if ( sign != 0 )
+    dest[pos++] = sign;
+  if ( (flags & (U8X8_FIX_LEFT|U8X8_FIX_ZERO)) == U8X8_FIX_ZERO )
+    while( len + pos - (sign != 0) < width )
+      dest[pos++] = '0';
+  for( i = first; i < point; i++ )
+    dest[pos++] = digits[i];
+  if ( frac != 0 )
+  {
+    dest[pos++] = '.';
+    for( i = point; i < point+frac; i++ )
+      dest[pos++] = i < 10 ? digits[i] : '0';
+  }
+  while( pos < width )
+    dest[pos++] = ' ';
+  dest[pos] = '\0';
+  return pos;
+}
@@ -1,120 +1,197 @@
 #include "u8g2_d.h"
+#include "Icon.h"     //tile格式的图标，由tools/xbm2tile.py从Hardware/Icon/*.xbm生成
+#include "Anim.h"
+#include "Menu.h"
+#if OLED_MIRROR
+#include "Mirror.h"
+#endif
 
 unsigned char OLED_GRAM[144][8];
 /*
 	给到外部电流的数据
 */
 Ele Current[3];
-char Ele_Buff[100];
 unsigned char Lin_buff[3][10]={0};
-//XBMP图标数据 ，定义一个大的数组直接扫描所有的图片 通过位移x，来达到运动效果
- unsigned char ICON[][300] = 
- {
-    {
-        0xF0,0xFF,0xFF,0xFF,0xFF,0x00,0xFC,0xFF,0xFF,0xFF,0xFF,0x03,0xFE,0xFF,0x00,0x00,0xFE,0x07,0xFE,0x7F,0x00,0x00,0xFE,0x07,0xFF,0x7F,0x00,0x00,0xFF,0x0F,0xFF,0x3F,
-        0x00,0x80,0xFF,0x0F,0xFF,0x3F,0x00,0x80,0xFF,0x0F,0xFF,0x3F,0x00,0xC0,0xFF,0x0F,0xFF,0x1F,0x00,0xC0,0xFF,0x0F,0xFF,0x1F,0x00,0xE0,0xFF,0x0F,0xFF,0x1F,0x00,0xE0,
-        0xFF,0x0F,0xFF,0x0F,0x00,0xF0,0xFF,0x0F,0xFF,0x0F,0x00,0xF0,0xFF,0x0F,0xFF,0x07,0x00,0xF8,0xFF,0x0F,0xFF,0x07,0x00,0xF8,0xFF,0x0F,0xFF,0x07,0x00,0xFC,0xFF,0x0F,
-        0xFF,0x03,0x00,0x00,0xE0,0x0F,0xFF,0x03,0x00,0x00,0xF0,0x0F,0xFF,0x01,0x00,0x00,0xF0,0x0F,0xFF,0x01,0x00,0x00,0xF8,0x0F,0xFF,0x01,0x00,0x00,0xFC,0x0F,0xFF,0x00,
-        0x00,0x00,0xFE,0x0F,0xFF,0x00,0x00,0x00,0xFF,0x0F,0xFF,0x00,0x00,0x80,0xFF,0x0F,0x7F,0x00,0x00,0x80,0xFF,0x0F,0xFF,0xFF,0x03,0xC0,0xFF,0x0F,0xFF,0xFF,0x07,0xE0,
-        0xFF,0x0F,0xFF,0xFF,0x07,0xF0,0xFF,0x0F,0xFF,0xFF,0x07,0xF8,0xFF,0x0F,0xFF,0xFF,0x03,0xF8,0xFF,0x0F,0xFF,0xFF,0x03,0xFC,0xFF,0x0F,0xFF,0xFF,0x03,0xFE,0xFF,0x0F,
-        0xFF,0xFF,0x01,0xFF,0xFF,0x0F,0xFF,0xFF,0x81,0xFF,0xFF,0x0F,0xFF,0xFF,0x81,0xFF,0xFF,0x0F,0xFF,0xFF,0xC0,0xFF,0xFF,0x0F,0xFF,0xFF,0xE0,0xFF,0xFF,0x0F,0xFF,0xFF,
-        0xF0,0xFF,0xFF,0x0F,0xFF,0xFF,0xF8,0xFF,0xFF,0x0F,0xFF,0x7F,0xFC,0xFF,0xFF,0x0F,0xFE,0x7F,0xFE,0xFF,0xFF,0x07,0xFE,0x7F,0xFF,0xFF,0xFF,0x07,0xFC,0xFF,0xFF,0xFF,
-        0xFF,0x03,0xF0,0xFF,0xFF,0xFF,0xFF,0x00
-    },//ele
-    {
-        0xF0,0xFF,0xFF,0xFF,0xFF,0x00,0xFC,0xFF,0xFF,0xFF,0xFF,0x03,0xFE,0xFF,0xFF,0xFF,0xFF,0x07,0xFE,0xFF,0xFF,0xFF,0xFF,0x07,0x1F,0x00,0x00,0x00,0x00,0x0F,0x1F,0x00,
-        0x00,0x00,0x00,0x0E,0xC7,0xFF,0xFF,0xFF,0xFF,0x0C,0xE7,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,
-        0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,
-        0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0x01,0x00,0x00,0xF0,0x0C,0xF3,0x00,0x00,0x00,0xF8,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,
-        0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0x01,0x00,0xF8,0xFF,0x0C,0xF3,0x00,0x00,0xFC,
-        0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,0xF3,0xFF,0xFF,0xFF,0xFF,0x0C,
-        0xE7,0xFF,0xFF,0xFF,0x7F,0x0E,0x0F,0xF0,0x07,0x00,0x00,0x0F,0x1F,0xF0,0x07,0x00,0x80,0x0F,0xFF,0xE7,0xF3,0xFF,0xFF,0x0F,0xFF,0x8F,0xF9,0xFF,0xFF,0x0F,0xFF,0x1F,
-        0xFC,0xFF,0xFF,0x0F,0xFF,0x3F,0xFE,0xFF,0xFF,0x0F,0xFF,0xFF,0xFF,0xFF,0xFF,0x0F,0xFE,0xFF,0xFF,0xFF,0xFF,0x07,0xFE,0xFF,0xFF,0xFF,0xFF,0x07,0xFC,0xFF,0xFF,0xFF,
-        0xFF,0x03,0xF0,0xFF,0xFF,0xFF,0xFF,0x00
-    }//lin
-};
 
 
 
 u8g2_t u8g2;   //u8g2结构体
+#if OLED_PAGE_MODE
+u8g2_dlist_t OLED_List;          //这一帧的画图命令，每页回放一次
+uint32_t OLED_ListBuf[OLED_LIST_SIZE/4];
+#else
+uint8_t OLED_Shadow[128*64/8];   //上一次发出去的画面，u8g2_SendBuffer只发和它不一样的tile
+uint8_t OLED_BackBuf[128*64/8];  //第二块帧缓冲，和u8g2自带的缓冲轮流使用
+uint8_t *OLED_FrameBuf[2];       //[0]u8g2自带的缓冲 [1]OLED_BackBuf
+u8g2_area_t OLED_FrameArea[2];   //两块缓冲各自画过的区域，切换缓冲时跟着换，清屏只清这一块
+#endif
+u8g2_text_cache_t OLED_Label[6]; //不变的表头文字，第一次画时渲染成tile格式，之后每帧直接拷贝
+uint8_t OLED_LabelBuf[6][2*32];  //每个表头两页高，最多32列
+u8g2_digit_cache_t OLED_Digit;   //"0123456789 +-."和单位字母，每个字符渲染成一格tile，数值字段只拷贝变了的几位
+uint8_t OLED_DigitBuf[16*(1+2*8)];   //16个字符，每格1字节宽度加上两页高、最多8列的tile
+Plot_t OLED_Plot;                //电流曲线，每个电流样本由主循环加进来
+uint8_t OLED_PlotCh = 0;         //曲线和大数字显示的电流通道(Acq的通道号)，曲线界面上下键切换
+Scope_t OLED_Scope;              //曲线界面OK键抓的一段突发波形，由主循环交给Acq
+
+static unsigned char OLED_Dirty = 1;      //有输入/新数据，下一轮要重画
+static unsigned char OLED_Animating = 0;  //菜单动画还没走完，要继续出帧
+static unsigned char OLED_KeyLast = 0;    //上一帧处理完以后剩下的按键位
+static uint32_t OLED_FrameTick = 0;       //上一帧开始的时间 ms
+static uint8_t OLED_StartLine = 0;        //这一帧要用的显示起始行，画的时候按显存坐标画，提交时一起切过去
+#if OLED_MIRROR
+static Mirror_t OLED_Mirror;              //串口镜像，记着还没发出去的tile
+static uint32_t OLED_MirrorTick = 0;      //上一次整屏重发的时间 ms
+static uint32_t OLED_MirrorSent = 0;      //上一包开始发送的时间 ms
+#endif
 
-//用来做pid的核心函数?   speed控制速度   ，c_speed保障震荡
-int run_str(int *now,int *trag,const int speed,const int c_speed)
+#if OLED_MIRROR
+//发给屏之前调用: 和影子缓冲(屏上现在的内容)比，记下这一帧变了的tile
+static void OLED_MirrorMark(u8g2_t *u8g2)
 {
-	int temp = 0;
-	if (*now > *trag)
-	{
-		temp = ((*now - *trag) > c_speed) ? speed : c_speed;
-		*now -= temp;
-	}
-	else if (*now < *trag)
-	{
-		temp = ((*trag - *now) > c_speed) ? speed : c_speed;
-		*now += temp;
-	}
-	else 
-	{
-		return 1;
-	}
-	return 0;
+	Mirror_Mark(&OLED_Mirror,u8g2_GetBufferPtr(u8g2),u8g2->is_shadow_valid ? u8g2->shadow_buf_ptr : NULL);
 }
 
-unsigned char Move(int *Main_Menu_x_taget,int *Main_Menu_y_taget,unsigned char x, unsigned char y)
+//串口空着就把记下的tile发出去，内容从影子缓冲取，就是屏上现在的画面；串口忙或者离上一包不到MIRROR_PERIOD就等下次
+static void OLED_MirrorSend(void)
 {
-	if(GetLeft)                                 
-	{
-		ClrLeft;
-		*Main_Menu_x_taget+=x;
-		PRINTF("Key Main_Menu_x_taget  %d\n",*Main_Menu_x_taget );
-		return 2;
-	}
-	if(GetRight)
-	{
-		ClrRight;
-		*Main_Menu_x_taget-=x;
-		PRINTF("Key Main_Menu_x_taget  %d\n",*Main_Menu_x_taget );
-		return 3;
-	}
-	if(GetUp)
+	uint32_t now = OSIF_GetMilliseconds();
+	uint32_t remain;
+	uint16_t len;
+
+	if(now - OLED_MirrorTick >= MIRROR_REFRESH)
 	{
-		ClrUp;
-		*Main_Menu_y_taget-=y;
-		PRINTF("Key Main_Menu_y_taget  %d\n",*Main_Menu_y_taget );
+		OLED_MirrorTick = now;
+		Mirror_Invalidate(&OLED_Mirror);
 	}
-	if(GetDown)
+	if(now - OLED_MirrorSent < MIRROR_PERIOD)
+		return;
+	if(OLED_Scope.exporting)      //导出CSV时串口让给PRINTF，变了的tile留到导出完再发
+		return;
+	if(UART_DRV_GetTransmitStatus(OLED_MIRROR_UART,&remain) == STATUS_BUSY)
+		return;
+	len = Mirror_Encode(&OLED_Mirror,OLED_Shadow,u8g2_GetU8x8(&u8g2)->start_line);
+	if(len != 0)
 	{
-		ClrDown;
-		*Main_Menu_y_taget+=y;
-		PRINTF("Key Main_Menu_y_taget  %d\n",*Main_Menu_y_taget );
+		OLED_MirrorSent = now;
+		UART_DRV_SendData(OLED_MIRROR_UART,OLED_Mirror.buf,len);
 	}
-	if(GetOk)
+}
+#endif
+
+#if OLED_HW_SCROLL
+/*
+	主菜单图标竖着排，每个图标占一屏(64行)，pos是往下滚过的行数
+	SSD1306在屏幕第y行显示显存第(y+起始行)%64行，起始行设成pos%64，
+	显存第r行要放的是现在看得见的那一行: r>=起始行的放第一段，r<起始行的放下一屏的开头
+	动画时只有新露出来的几行变了，OLED_FlushDMA只发这几页，其余的内容靠起始行挪过去
+*/
+static void OLED_DrawIconScroll(int pos)
+{
+	int base,top;
+	unsigned char i,seg;
+
+	OLED_StartLine = pos & 63;
+	for(seg=0;seg<2;seg++)
 	{
-		ClrOk;
-		return 1;
+		if(seg == 0)
+			u8g2_SetClipWindow(&u8g2,0,OLED_StartLine,128,64);
+		else if(OLED_StartLine != 0)
+			u8g2_SetClipWindow(&u8g2,0,0,128,OLED_StartLine);
+		else
+			break;
+		base = (pos & ~63) + seg*64;          //这一段显存第0行对应的图标列表里的行
+		for(i=0;i<ICON_NUM;i++)
+		{
+			top = 10 + i*64 - base;
+			if(top > -ICON_HEIGHT && top < 64)
+				u8g2_DrawTileBitmap(&u8g2,42,top,ICON_WIDTH,ICON_HEIGHT,ICON_Tile[i]);
+		}
 	}
+	u8g2_SetMaxClipWindow(&u8g2);
+}
+#endif
+
+/*
+	电流配置: 3路，每路 最小 最大 时间，摇杆偏着时每帧加减1
+*/
+static const Menu_Field_t Menu_CurrentField[] =
+{
+	MENU_LABEL_FIELD(14,12,24,&OLED_Label[0],"最小"),
+	MENU_LABEL_FIELD(50,12,24,&OLED_Label[1],"最大"),
+	MENU_LABEL_FIELD(86,12,24,&OLED_Label[2],"时间"),
+	MENU_INT_FIELD(10,25,4,&Current[0].min,0,5000,0),MENU_INT_FIELD(46,25,4,&Current[0].max,0,5000,0),MENU_INT_FIELD(82,25,4,&Current[0].time,0,50,0),
+	MENU_INT_FIELD(10,37,4,&Current[1].min,0,5000,0),MENU_INT_FIELD(46,37,4,&Current[1].max,0,5000,0),MENU_INT_FIELD(82,37,4,&Current[1].time,0,50,0),
+	MENU_INT_FIELD(10,49,4,&Current[2].min,0,5000,0),MENU_INT_FIELD(46,49,4,&Current[2].max,0,5000,0),MENU_INT_FIELD(82,49,4,&Current[2].time,0,50,0),
+};
+static const Menu_Form_t Menu_CurrentForm = {Menu_CurrentField,12,3,3,3,MENU_CURSOR_ARROW,MENU_EDIT_AIN};
+
+/*
+	LIN报文: 3帧，每帧10个字节，一行放不下，光标走到边上时整行滚动，上下键加减
+*/
+#define LIN_FIELD(i,j) MENU_U8_FIELD((j)*18,34+(i)*12,3,&Lin_buff[i][j],0,255,MENU_F_SCROLL)
+#define LIN_ROW(i)     LIN_FIELD(i,0),LIN_FIELD(i,1),LIN_FIELD(i,2),LIN_FIELD(i,3),LIN_FIELD(i,4),\
+                       LIN_FIELD(i,5),LIN_FIELD(i,6),LIN_FIELD(i,7),LIN_FIELD(i,8),LIN_FIELD(i,9)
+static const Menu_Field_t Menu_LinField[] =
+{
+	MENU_LABEL_FIELD( 3,12,12,&OLED_Label[3],"ID"),
+	MENU_LABEL_FIELD(21,12,24,&OLED_Label[4],"时间"),
+	MENU_LABEL_FIELD(60,12,24,&OLED_Label[5],"报文"),
+	LIN_ROW(0),
+	LIN_ROW(1),
+	LIN_ROW(2),
+};
+static const Menu_Form_t Menu_LinForm = {Menu_LinField,33,3,10,3,MENU_CURSOR_LINE,MENU_EDIT_KEY};
+
+static const Menu_Form_t *const OLED_Form[4] = {NULL,&Menu_CurrentForm,&Menu_LinForm,NULL};  //按MenuFlag查，NULL是每帧整屏重画的界面
+static Menu_t OLED_Menu;
+
+//u8g2现在画的是哪块帧缓冲，Menu_Draw按块记哪些字段还没画新值
+static uint8_t OLED_BackIndex(void)
+{
+#if OLED_PAGE_MODE
 	return 0;
+#else
+	return u8g2_GetBufferPtr(&u8g2) == OLED_FrameBuf[1];
+#endif
 }
+
 void  Menu_Show(void)//显示菜单  这里显示了所有的图片
 {
- 	signed char Value;										 //每次的增量值
-	unsigned char x,y,ret;									    //用来确定当前位置
-	
-	static unsigned char MenuFlag=0,CtrlFlag=0;           //两个都菜单选择变量
-	static int Main_Menu_x = 42,Main_Menu_x_taget = 42,Main_Menu_y = 0,Main_Menu_y_taget = 0,Main_Menu_x_1 = 0;// PID控制的位置变量
-    unsigned char i ;
+	static unsigned char MenuFlag=0;                      //当前界面
+	static int Main_Menu_x = 42,Main_Menu_x_taget = 42;  //主菜单图标的位置，动画控制
+	static Anim_t Menu_Anim = ANIM_INIT(&Main_Menu_x,42,ANIM_TIME);
+	uint32_t now = OSIF_GetMilliseconds();
+	unsigned char anim = 0;
+	u8g2_uint_t px;
+#if !OLED_HW_SCROLL
+	unsigned char i;
+#endif
+#if OLED_PAGE_MODE
+	u8g2_BeginDisplayList(&u8g2,&OLED_List);   //下面的画图只录命令，发送时每页回放一次，不在这一页的命令直接跳过
+	if(OLED_Form[MenuFlag] != NULL)
+		Menu_Invalidate(&OLED_Menu);            //页缓冲留不住上一帧，表格界面也每帧整屏画
+#else
+	if(OLED_Form[MenuFlag] == NULL)
+		u8g2_ClearDrawnArea(&u8g2);     //只清上次在这块缓冲上画过的区域；表格界面是保留的，由Menu_Draw只清要重画的字段
+#endif
+	OLED_StartLine = 0;                 //只有主菜单的图标滚动用起始行，其他菜单按屏幕坐标画
 	switch (MenuFlag)
 	{
 	case 0:
-		for(i=0;i<2;i++)
+#if OLED_HW_SCROLL
+		OLED_DrawIconScroll((42-Main_Menu_x)/2);   //Main_Menu_x从42走到-86是一个图标，对应竖着滚64行
+#else
+		for(i=0;i<ICON_NUM;i++)
 		{
-			u8g2_DrawXBMP(&u8g2,Main_Menu_x+i*128,10,44,44,ICON[i]);
+			u8g2_DrawTileBitmap(&u8g2,Main_Menu_x+i*128,10,ICON_WIDTH,ICON_HEIGHT,ICON_Tile[i]);
 		}   
+#endif
 		if(GetRight)
 		{
 			ClrRight;
 			Main_Menu_x_taget +=128;
 			Main_Menu_x_taget = Main_Menu_x_taget>42?42:Main_Menu_x_taget; //限位
-			PRINTF("Key one %d\n",Main_Menu_x_taget);
+			OLED_LOG("Key one %d\n",Main_Menu_x_taget);
 			
 		}
 		if(GetLeft)
@@ -122,7 +199,7 @@ void  Menu_Show(void)//显示菜单  这里显示了所有的图片
 			ClrLeft;
 			Main_Menu_x_taget -=128;
 			Main_Menu_x_taget = Main_Menu_x_taget<-86?-86:Main_Menu_x_taget;
-			PRINTF("Key two  %d\n",Main_Menu_x_taget );
+			OLED_LOG("Key two  %d\n",Main_Menu_x_taget );
 			
 		}
 		if(GetOk)
@@ -130,164 +207,74 @@ void  Menu_Show(void)//显示菜单  这里显示了所有的图片
 			ClrOk;
 			
 			MenuFlag = (unsigned char)((42-Main_Menu_x_taget)/128)+1;
-			Main_Menu_x = 0,Main_Menu_x_taget = 0,Main_Menu_y = 0,Main_Menu_y_taget = 18;
-			PRINTF("Key two  %d\n",MenuFlag );
+			Menu_Enter(&OLED_Menu,OLED_Form[MenuFlag]);
+			OLED_LOG("Key two  %d\n",MenuFlag );
 		}
 		
 		break;
-	case 1:
-		
-        u8g2_DrawUTF8(&u8g2,14,12,"最小");
-        u8g2_DrawUTF8(&u8g2,50,12,"最大");
-        u8g2_DrawUTF8(&u8g2,86,12,"时间");
-		for(i=0;i<3;i++)
-		{
-			sprintf(Ele_Buff,"%4d  %4d  %4d" ,Current[i].min,Current[i].max,Current[i].time);
-			u8g2_DrawUTF8(&u8g2,10,25+(i*12),Ele_Buff);
-		}
-        
-		if(GetLOk)   //这里是返回键
+	case 1:  //电流配置，字段见Menu_CurrentField
+		if(Menu_Input(&OLED_Menu) == MENU_BACK)   //返回键回主菜单
 		{
-			ClrLOk;
 			MenuFlag = 0;
-			CtrlFlag = 0;
 			Main_Menu_x_taget = 42;
-		}
-		/*	
-			反算出当前所在的位置
-			这里是进行数值加减的地方
-		*/
-		if(CtrlFlag)
-		{
-			y = (Main_Menu_y_taget-22)/10;    
-			x = (Main_Menu_x_taget-6)/36;
-			Value = AINX>2500?1:AINX<1500?-1:0;
-			u8g2_DrawRFrame(&u8g2,Main_Menu_x,Main_Menu_y,31,12,2);
-
-			if(GetOk)
-			{
-				ClrOk;
-				CtrlFlag= 0;
-				
-			}
-			
-			switch (x)//这里是对电流配置的加减
-			{
-				case 0:
-					Current[y].min+=Value;
-					Current[y].min = Current[y].min <= 0 ?0:Current[y].min;
-					Current[y].min = Current[y].min >= 5000 ?5000:Current[y].min;
-					break;
-				case 1:
-					Current[y].max+=Value;
-					Current[y].max = Current[y].max <= 0 ?0:Current[y].max;
-					Current[y].max = Current[y].max >= 5000 ?5000:Current[y].max;
-					break;
-				case 2:
-					Current[y].time+=Value;
-					Current[y].time = Current[y].time <= 0 ?0:Current[y].time;
-					Current[y].time = Current[y].time >= 50 ?50:Current[y].time;
-					break;
-				default:
-					break;
-			}
-		
-			PRINTF(" Value %d  AINX %d\n",Value, AINY );
 			break;
 		}
-		else
-		{
-			/*
-				这里是对菜单的移动
-			*/
-			if(Move(&Main_Menu_x_taget,&Main_Menu_y_taget,36,12)==1)
-				CtrlFlag = 1;
-			u8g2_DrawTriangle(&u8g2,Main_Menu_x,Main_Menu_y,Main_Menu_x,Main_Menu_y+8,Main_Menu_x+4,Main_Menu_y+4);
-			// u8g2_DrawBox(&u8g2,Main_Menu_x,Main_Menu_y,2,10);
-		
-		}
-		Main_Menu_x_taget = Main_Menu_x_taget<6?6:Main_Menu_x_taget;
-		Main_Menu_x_taget = Main_Menu_x_taget>78?78:Main_Menu_x_taget;
-		Main_Menu_y_taget = Main_Menu_y_taget<12?12:Main_Menu_y_taget;
-		Main_Menu_y_taget = Main_Menu_y_taget>60?60:Main_Menu_y_taget;
+		anim = Menu_Draw(&OLED_Menu,&u8g2,OLED_BackIndex(),now);
 		break;
-	case 2:  //这里是Lin的菜单
-		u8g2_DrawUTF8(&u8g2, 3,12,"ID");
-        u8g2_DrawUTF8(&u8g2,21,12,"时间");
-		u8g2_DrawUTF8(&u8g2,60,12,"报文");
-		if(GetLOk)
+	case 2:  //LIN报文，字段见Menu_LinField
+		if(Menu_Input(&OLED_Menu) == MENU_BACK)   //返回键去电流曲线
 		{
-			ClrLOk;
 			MenuFlag = 3;
+			break;
 		}
-		for(i=0;i<3;i++)
+		anim = Menu_Draw(&OLED_Menu,&u8g2,OLED_BackIndex(),now);
+		break;
+	case 3:
+		//按键都在画之前处理: 页模式录的是OLED_Plot.bmp的指针，录完到发完之间曲线不能再变
+		if((GetUp || GetDown) && OLED_Scope.state == SCOPE_IDLE)
 		{
-			sprintf(Ele_Buff,"%3d%3d%3d%3d%3d%3d%3d%3d%3d%3d" ,Lin_buff[i][0],Lin_buff[i][1],Lin_buff[i][2],Lin_buff[i][3],Lin_buff[i][4],Lin_buff[i][5],Lin_buff[i][6],Lin_buff[i][7],Lin_buff[i][8],Lin_buff[i][9]);	
-			u8g2_DrawUTF8(&u8g2,Main_Menu_x_1,34+(i*12),Ele_Buff);
-			
+			//换一路: 这一帧的大数字、曲线和通道名就是新的这一路
+			OLED_PlotCh = GetUp ? (OLED_PlotCh+OLED_PLOT_CHS-1)%OLED_PLOT_CHS : (OLED_PlotCh+1)%OLED_PLOT_CHS;
+			Current_vlue = Current_Chan[OLED_PlotCh];
+			Plot_Init(&OLED_Plot,OLED_PLOT_PER_COL);
 		}
-		if(CtrlFlag == 0)
+		ClrUp;
+		ClrDown;
+		if(GetOk)
 		{
-		
-			
-			// u8g2_DrawBox(&u8g2,Main_Menu_x,Main_Menu_y,2,10);
-			u8g2_DrawLine(&u8g2,Main_Menu_x,Main_Menu_y,Main_Menu_x+5,Main_Menu_y);
-			if(Main_Menu_x_taget<60)
-				ret = Move(&Main_Menu_x_taget,&Main_Menu_y_taget,10,12);
-			else                         //这里是配合我横线的移动
-			{
-				ret = Move(&Main_Menu_x_taget,&Main_Menu_y_taget,5,12);
-				if(Main_Menu_x_taget<120&&Main_Menu_x_taget>60) //为了做限位不然一直跑
-				{
-					if(ret == 3)
-						Main_Menu_x_1 += 5;
-					if(ret == 2)
-						Main_Menu_x_1 -= 5;
-				}
-				
-			}
-			if(ret==1)
+			ClrOk;
+			if(OLED_Scope.state == SCOPE_IDLE)   //抓一次，阈值用电流配置里这一路的最小/最大(mA)
+				Scope_Arm(&OLED_Scope,OLED_SCOPE_TRIG,Current[OLED_PlotCh].min*1000,Current[OLED_PlotCh].max*1000,
+					OLED_SCOPE_PRE,SCOPE_DEPTH-OLED_SCOPE_PRE);
+			else
 			{
-				CtrlFlag = 1;
+				Scope_Stop(&OLED_Scope);         //不抓了/看完了，回到实时曲线
+				Plot_Init(&OLED_Plot,OLED_PLOT_PER_COL);
 			}
-		
 		}
-		else
+		if(GetRight)
 		{
-			x = Main_Menu_x_taget/12;
-			y = (Main_Menu_y_taget-35)/12;	
-			if(GetUp)
-			{
-				ClrUp;
-				Lin_buff[y][x] += 1;
-				PRINTF("Key Main_Menu_y_taget  %d\n",Main_Menu_y_taget );
-			}
-			if(GetDown)
-			{
-				ClrDown;
-				Lin_buff[y][x] -= 1;
-				PRINTF("Key Main_Menu_y_taget  %d\n",Main_Menu_y_taget );
-			}
-			if(GetOk)
-			{
-				ClrOk;
-				CtrlFlag = 0;
-			}
+			ClrRight;
+			if(OLED_Scope.state == SCOPE_DONE)
+				Scope_Export(&OLED_Scope);       //CSV从串口打出来，主循环里OLED_Export一轮打几行
+		}
+		px = u8g2_DrawFixedDigits(&u8g2,&OLED_Digit,0,12,Current_vlue,NULL,3,3,0,0);   //uA显示成mA，3位小数
+		u8g2_DrawDigits(&u8g2,&OLED_Digit,px+2,12,"mA",NULL);
+		Plot_Draw(&OLED_Plot,&u8g2,0,16);                       //曲线只在有新样本时变，这里只是整块拷贝
+		u8g2_DrawVLine(&u8g2,PLOT_WIDTH,16,PLOT_HEIGHT);
+		u8g2_DrawFixedDigits(&u8g2,&OLED_Digit,PLOT_WIDTH+2,24,OLED_Plot.hi,NULL,3,1,0,0); //纵轴上下限 mA
+		u8g2_DrawFixedDigits(&u8g2,&OLED_Digit,PLOT_WIDTH+2,63,OLED_Plot.lo,NULL,3,1,0,0);
+		{
+			char name[] = "CH1";
+			name[2] = '1'+OLED_PlotCh;
+			u8g2_DrawStr(&u8g2,PLOT_WIDTH+2,12,name);
+		}
+		if(OLED_Scope.state != SCOPE_IDLE)
+		{
+			static const char *const name[] = {"","ARM","WAIT","REC","HOLD"};   //字库子集里有ASCII
+			u8g2_DrawStr(&u8g2,PLOT_WIDTH+2,44,name[OLED_Scope.state]);
 		}
-		
-		/*
-			限位
-		// */
-	
-		PRINTF("  AINX %d\n",Main_Menu_x_taget );
-		Main_Menu_x_taget = Main_Menu_x_taget<6?6:Main_Menu_x_taget;
-		Main_Menu_x_taget = Main_Menu_x_taget>120?120:Main_Menu_x_taget;
-		Main_Menu_y_taget = Main_Menu_y_taget<35?35:Main_Menu_y_taget;
-		Main_Menu_y_taget = Main_Menu_y_taget>59?59:Main_Menu_y_taget;
 		break;
-		case 3:
-			sprintf(Ele_Buff,"%f ",Current_vlue) ;
-			u8g2_DrawUTF8(&u8g2,50,34,Ele_Buff);
 	default:
 		break;
 	}
@@ -295,19 +282,148 @@ void  Menu_Show(void)//显示菜单  这里显示了所有的图片
     /*
 		这里是位置的移动解算，以及刷新
 	*/
-
-    run_str(&Main_Menu_x,&Main_Menu_x_taget,3,1);   //每次进行运算以一定的速度靠近X_taget
-	run_str(&Main_Menu_y,&Main_Menu_y_taget,3,1);   //每次进行运算以一定的速度靠近Y_taget
+	Anim_To(&Menu_Anim,Main_Menu_x_taget,now);  //目标变了就从当前位置重新开始一段，ANIM_TIME ms走完
+	OLED_Animating = Anim_Update(&Menu_Anim,now) || anim;
+#if OLED_PAGE_MODE
+	u8g2_EndDisplayList(&u8g2);
+	if(OLED_List.is_overflow)                  //列表装不下，后面的命令丢了，要加大OLED_LIST_SIZE
+		OLED_LOG("display list overflow %d\n",OLED_List.need);
+#endif
+#if OLED_FLUSH_DMA
+	if(OLED_Present(&u8g2) == OLED_PRESENT_BUSY)  //上一帧没发完就丢掉这一帧，下一轮重画；发送期间主循环可以去采集
+		OLED_Dirty = 1;
+#else
+#if OLED_MIRROR
+	OLED_MirrorMark(&u8g2);
+#endif
+	OLED_BusBegin();                //整帧只拉一次CS
+#if OLED_PAGE_MODE
+	u8g2_SendDisplayList(&u8g2,&OLED_List);
+#else
 	u8g2_SendBuffer(&u8g2);
-	u8g2_ClearBuffer(&u8g2);
-    
-    
+#endif
+	if(OLED_StartLine != u8g2_GetU8x8(&u8g2)->start_line)
+		u8x8_SetDisplayStartLine(u8g2_GetU8x8(&u8g2),OLED_StartLine);
+	OLED_BusEnd();
+#endif
+#if OLED_MIRROR
+	OLED_MirrorSend();
+#endif
 }
 
 
 
 
 
+void OLED_RequestRedraw(void)
+{
+	OLED_Dirty = 1;
+}
+
+/*
+	主循环调用，代替直接调用Menu_Show
+	只有按键位变了、摇杆没回中(编辑数值时一直在加减)、有人调了OLED_RequestRedraw
+	或者菜单动画还没走完时才画，并且两帧间隔不小于1000/OLED_FPS ms
+	返回1表示这一轮画了一帧
+*/
+unsigned char OLED_Task(void)
+{
+	uint32_t now;
+
+#if OLED_MIRROR
+	OLED_MirrorSend();                  //上一包发完了就接着发剩下的tile
+#endif
+	if(PotenmeterFlag != OLED_KeyLast || AINX > 2500 || AINX < 1500 || AINY > 2500 || AINY < 1500)
+		OLED_Dirty = 1;
+	if(!OLED_Dirty && !OLED_Animating)
+		return 0;
+	now = OSIF_GetMilliseconds();
+	if(now - OLED_FrameTick < 1000/OLED_FPS)
+		return 0;
+	OLED_FrameTick = now;
+	OLED_Dirty = 0;
+	Menu_Show();
+	OLED_KeyLast = PotenmeterFlag;
+	return 1;
+}
+
+/*
+	主循环调用: 曲线界面右键开始的CSV导出，每轮打几行，中间照常采集和刷屏
+	镜像包还在发的时候先不打(PRINTF的字会丢)，导出期间不发新的镜像包
+	返回1表示还没打完
+*/
+unsigned char OLED_Export(void)
+{
+#if OLED_MIRROR
+	uint32_t remain;
+
+	if(OLED_Scope.exporting && UART_DRV_GetTransmitStatus(OLED_MIRROR_UART,&remain) == STATUS_BUSY)
+		return 1;
+#endif
+	return Scope_ExportStep(&OLED_Scope);
+}
+
+/*
+	SPI批量发送
+	连续的命令字节、连续的数据字节先攒在OLED_TxBuf里，DC要变或者缓冲满了才真正发一次，
+	DC只在命令/数据交界处切换，CS在OLED_BusBegin和最外层的OLED_BusEnd之间一直拉低
+	大块数据(整页显存)不拷贝，直接从调用者的缓冲发出
+*/
+static uint8_t OLED_TxBuf[OLED_TX_SIZE];
+static uint16_t OLED_TxLen = 0;
+static uint8_t OLED_TxDC = 0xFF;       //DC脚当前电平，0xFF表示这次传输还没设过
+static uint8_t OLED_TxDepth = 0;       //BusBegin嵌套层数，u8g2整帧发送里面每行还会再Begin/End一次
+
+static void OLED_BusFlush(void)
+{
+	if(OLED_TxLen == 0)
+		return;
+	SPI_DRV_MasterTransferBlocking(SPI_INST,OLED_TxBuf,NULL,OLED_TxLen,OLED_TX_TIMEOUT);
+	OLED_TxLen = 0;
+}
+
+void OLED_BusBegin(void)
+{
+	if(OLED_TxDepth++ == 0)
+	{
+		OLED_FlushWait();               //DMA还在发上一帧时不能插进去
+		OLED_TxDC = 0xFF;               //OLED_FlushDMA会直接改DC脚
+		OLED_CS_Clr();
+	}
+}
+
+void OLED_BusWrite(unsigned char dc,const uint8_t *dat,uint16_t len)
+{
+	if(dc != OLED_TxDC)
+	{
+		OLED_BusFlush();
+		if(dc)
+			OLED_DC_Set();
+		else
+			OLED_DC_Clr();
+		OLED_TxDC = dc;
+	}
+	if(len >= OLED_TX_SIZE)
+	{
+		OLED_BusFlush();
+		SPI_DRV_MasterTransferBlocking(SPI_INST,dat,NULL,len,OLED_TX_TIMEOUT);
+		return;
+	}
+	while(len--)
+	{
+		if(OLED_TxLen == OLED_TX_SIZE)
+			OLED_BusFlush();
+		OLED_TxBuf[OLED_TxLen++] = *dat++;
+	}
+}
+
+void OLED_BusEnd(void)
+{
+	OLED_BusFlush();
+	if(OLED_TxDepth != 0 && --OLED_TxDepth == 0)
+		OLED_CS_Set();
+}
+
 /* USER CODE BEGIN PD */
 uint8_t u8g2_gpio_and_delay_YTM(U8X8_UNUSED u8x8_t *u8x8, U8X8_UNUSED uint8_t msg, U8X8_UNUSED uint8_t arg_int, U8X8_UNUSED void *arg_ptr)
 {
@@ -361,42 +477,217 @@ uint8_t u8g2_gpio_and_delay_YTM(U8X8_UNUSED u8x8_t *u8x8, U8X8_UNUSED uint8_t ms
 	return 1; // command processed successfully.
 }
 
+/*
+	u8x8的字节层，走上面的批量发送
+	u8x8_cad_001每个命令字节都会SetDC一次，这里只记下电平，真正切换在OLED_BusWrite里
+*/
+uint8_t u8x8_byte_YTM_spi(U8X8_UNUSED u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+	static uint8_t dc = 0;
+	switch(msg){
+		case U8X8_MSG_BYTE_SEND:
+			OLED_BusWrite(dc,(uint8_t *)arg_ptr,arg_int);
+		break;
+		case U8X8_MSG_BYTE_INIT:
+		break;
+		case U8X8_MSG_BYTE_SET_DC:
+			dc = arg_int;
+		break;
+		case U8X8_MSG_BYTE_START_TRANSFER:
+			OLED_BusBegin();
+		break;
+		case U8X8_MSG_BYTE_END_TRANSFER:
+			OLED_BusEnd();
+		break;
+		default:
+			return 0;
+	}
+	return 1;
+}
+
 void u8g2_init(void)
 {
-	
-    u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_4write_hw_spi, u8g2_gpio_and_delay_YTM);
+	unsigned char i;
+#if OLED_PAGE_MODE
+    u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, U8G2_R0, u8x8_byte_YTM_spi, u8g2_gpio_and_delay_YTM);
+#else
+    u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_YTM_spi, u8g2_gpio_and_delay_YTM);
+#endif
     u8g2_InitDisplay(&u8g2);
     u8g2_SetPowerSave(&u8g2,0);
    	u8g2_SetFontDirection(&u8g2, 0);
-	u8g2_SetFont(&u8g2, u8g2_font_wqy12_t_chinese3);
+	u8g2_SetFont(&u8g2, OLED_FONT);
     u8g2_ClearBuffer(&u8g2);
+#if OLED_PAGE_MODE
+	u8g2_InitDisplayList(&OLED_List,OLED_ListBuf,sizeof(OLED_ListBuf));
+#else
+	u8g2_SetShadowBuffer(&u8g2,OLED_Shadow);
+	OLED_FrameBuf[0] = u8g2_GetBufferPtr(&u8g2);
+	OLED_FrameBuf[1] = OLED_BackBuf;
+	u8g2_InvalidateDrawnArea(&u8g2);     //OLED_BackBuf还没用过，第一次清的时候整块清
+	OLED_FrameArea[1] = u8g2.drawn_area;
+	u8g2_ClearDrawnArea(&u8g2);
+#endif
+	for(i=0;i<6;i++)
+		u8g2_InitTextCache(&OLED_Label[i],OLED_LabelBuf[i],sizeof(OLED_LabelBuf[i]));
+	u8g2_InitDigitCache(&OLED_Digit,OLED_DigitBuf,sizeof(OLED_DigitBuf),"mA");
+	Menu_Init(&OLED_Menu,&OLED_Digit);
+#if OLED_MIRROR
+	Mirror_Init(&OLED_Mirror);
+#endif
+	Plot_Init(&OLED_Plot,OLED_PLOT_PER_COL);
+
+}
+
+/*
+	抓完的波形画到曲线上: 全部样本压成PLOT_WIDTH列以内，每列还是最小/最大值的包络
+	之后OK键回实时曲线前，主循环不再往OLED_Plot里加样本
+*/
+void OLED_ShowScope(Scope_t *s)
+{
+	uint16_t i,n = Scope_Count(s);
+
+	Plot_Init(&OLED_Plot,(uint8_t)((n+PLOT_WIDTH-1)/PLOT_WIDTH));
+	for(i=0;i<n;i++)
+		Plot_Add(&OLED_Plot,Scope_Get(s,i));
+	OLED_RequestRedraw();
+}
+
+/*
+	DMA整帧刷新
+	u8g2初始化序列已经把SSD1306设成水平寻址(0x20,0x00)，每帧只需把列/页窗口设成整屏，
+	u8g2的tile缓冲按页排列，和水平寻址的写入顺序一致，整块交给DMA发送即可
+	有影子缓冲时只发有变化的那几页(页在缓冲里是连续的)，画面没变就不发
+*/
+static spi_master_config_t OLED_DmaConfig;
+static volatile unsigned char OLED_DmaBusy = 0;
+static OLED_FlushCallback OLED_DmaDone = NULL;
+
+static void OLED_DMA_TransferEnd(void *driverState,spi_event_t event,void *userData)
+{
+	(void)driverState;
+	(void)event;
+	(void)userData;
+	if(OLED_DmaBusy)               //命令字节的阻塞发送也会进这里，只处理帧数据
+	{
+		OLED_CS_Set();
+		OLED_DmaBusy = 0;
+		if(OLED_DmaDone != NULL)
+			OLED_DmaDone();
+	}
+}
+
+void OLED_DMA_Init(void)
+{
+	OLED_DmaConfig = spi_MasterConfig0;
+	OLED_DmaConfig.transferType = SPI_USING_DMA;
+	OLED_DmaConfig.txDMAChannel = dmaChnConfigArray[0]->virtChnConfig;
+	//rx不配DMA通道: 所有传输的接收缓冲都是NULL，驱动只在有接收缓冲时才用rxDMAChannel
+	OLED_DmaConfig.callback = OLED_DMA_TransferEnd;
+	OLED_DmaConfig.callbackParam = NULL;
+	SPI_DRV_MasterConfigureBus(SPI_INST,&OLED_DmaConfig,NULL);
+}
+
+//返回1表示已启动发送，返回0表示上一帧还没发完或者启动失败
+unsigned char OLED_FlushDMA(u8g2_t *u8g2,OLED_FlushCallback done)
+{
+	uint8_t cmd[6];
+	uint8_t first,last;
+	uint16_t page_size,len;
+
+	if(OLED_DmaBusy)
+		return 0;
+#if OLED_MIRROR
+	OLED_MirrorMark(u8g2);
+#endif
+	if(u8g2_UpdateShadowBuffer(u8g2,&first,&last) == 0)
+	{
+		if(done != NULL)                              //画面没变，直接算发送完成
+			done();
+		return 1;
+	}
+	page_size = u8g2_GetBufferTileWidth(u8g2)*8;
+	len = page_size*(last-first+1);
+	cmd[0] = 0x21;                                    //列窗口 0~127
+	cmd[1] = 0;
+	cmd[2] = page_size-1;
+	cmd[3] = 0x22;                                    //页窗口 只覆盖有变化的页
+	cmd[4] = first;
+	cmd[5] = last;
 
+	OLED_DmaDone = done;
+	OLED_CS_Clr();
+	OLED_DC_Clr();
+	SPI_DRV_MasterTransferBlocking(SPI_INST,cmd,NULL,6,10);
+	OLED_DC_Set();
+	OLED_DmaBusy = 1;
+	if(SPI_DRV_MasterTransfer(SPI_INST,u8g2_GetBufferPtr(u8g2)+page_size*first,NULL,len) != STATUS_SUCCESS)
+	{
+		OLED_DmaBusy = 0;
+		OLED_CS_Set();
+		u8g2_InvalidateShadowBuffer(u8g2);            //影子已经当这些tile发出去了，作废它，下一帧整屏重发
+		return 0;
+	}
+	return 1;
+}
+
+unsigned char OLED_FlushBusy(void)
+{
+	return OLED_DmaBusy;
+}
+
+void OLED_FlushWait(void)
+{
+	while(OLED_DmaBusy);
+}
+
+#if !OLED_PAGE_MODE
+/*
+	双缓冲提交：把刚画好的缓冲交给DMA，u8g2切到另一块缓冲继续画
+	不会阻塞，上一帧还在发送时返回OLED_PRESENT_BUSY，什么都不做
+*/
+unsigned char OLED_Present(u8g2_t *u8g2)
+{
+	unsigned char front;
+
+	if(OLED_DmaBusy)
+		return OLED_PRESENT_BUSY;
+	front = (u8g2_GetBufferPtr(u8g2) == OLED_FrameBuf[0]) ? 0 : 1;
+	if(OLED_FlushDMA(u8g2,NULL) == 0)
+		return OLED_PRESENT_BUSY;
+	if(OLED_StartLine != u8g2_GetU8x8(u8g2)->start_line)   //起始行变了要等这一帧的显存发完再切，切过去时新露出来的行已经是新内容
+		u8x8_SetDisplayStartLine(u8g2_GetU8x8(u8g2),OLED_StartLine);  //OLED_BusBegin里会等DMA发完，只等几页的时间
+	OLED_FrameArea[front] = u8g2->drawn_area;
+	u8g2->tile_buf_ptr = OLED_FrameBuf[front^1];
+	u8g2->drawn_area = OLED_FrameArea[front^1];
+	return OLED_PRESENT_OK;
 }
+#endif
 
 void OLED_WR_Byte(unsigned char dat,unsigned char cmd)
 {	
-	unsigned char i;			  
-	if(cmd)
-	  OLED_DC_Set();
-	else
-	  OLED_DC_Clr();
-	OLED_CS_Clr();
-	SPI_DRV_MasterTransfer(SPI_INST, &dat, NULL, 1);			 		  
-	OLED_CS_Set();
-	OLED_DC_Set();   	  
+	OLED_BusBegin();
+	OLED_BusWrite(cmd,&dat,1);
+	OLED_BusEnd();
 }
 
 void OLED_Refresh(void)
 {
 	unsigned char i,n;
+	uint8_t addr[3];
+	uint8_t row[128];                   //OLED_GRAM是按列存的，先拼成一页再发
+	OLED_BusBegin();                    //整屏一次CS，每页一次命令一次数据
 	for(i=0;i<8;i++)
 	{
-	   OLED_WR_Byte(0xb0+i,OLED_CMD);
-	   OLED_WR_Byte(0x00,OLED_CMD);   
-	   OLED_WR_Byte(0x10,OLED_CMD);   
+	   addr[0] = 0xb0+i;
+	   addr[1] = 0x00;
+	   addr[2] = 0x10;
+	   OLED_BusWrite(OLED_CMD,addr,3);
 	   for(n=0;n<128;n++)
-		 OLED_WR_Byte(OLED_GRAM[n][i],OLED_DATA);
-  }
+		 row[n] = OLED_GRAM[n][i];
+	   OLED_BusWrite(OLED_DATA,row,128);
+	  }
+	OLED_BusEnd();
 }
 
 void OLED_Clear(void)
@@ -412,40 +703,44 @@ void OLED_Clear(void)
 	OLED_Refresh();
 }
 
+static const uint8_t OLED_InitCmd[] =
+{
+	0xAE,//--turn off oled panel
+	0x00,//---set low column address
+	0x10,//---set high column address
+	0x40,//--set start line address  Set Mapping RAM Display Start Line (0x00~0x3F)
+	0x81,//--set contrast control register
+	0xCF,// Set SEG Output Current Brightness
+	0xA1,//--Set SEG/Column Mapping
+	0xC8,//Set COM/Row Scan Direction
+	0xA6,//--set normal display
+	0xA8,//--set multiplex ratio(1 to 64)
+	0x3f,//--1/64 duty
+	0xD3,//-set display offset	Shift Mapping RAM Counter (0x00~0x3F)
+	0x00,//-not offset
+	0xd5,//--set display clock divide ratio/oscillator frequency
+	0x80,//--set divide ratio, Set Clock as 100 Frames/Sec
+	0xD9,//--set pre-charge period
+	0xF1,//Set Pre-Charge as 15 Clocks & Discharge as 1 Clock
+	0xDA,//--set com pins hardware configuration
+	0x12,
+	0xDB,//--set vcomh
+	0x40,//Set VCOM Deselect Level
+	0x20,//-Set Page Addressing Mode (0x00/0x01/0x02)
+	0x02,//
+	0x8D,//--set Charge Pump enable/disable
+	0x14,//--set(0x10) disable
+	0xA4,// Disable Entire Display On (0xa4/0xa5)
+	0xA6,// Disable Inverse Display On (0xa6/a7)
+	0xAF,
+};
+
 void OLED_Init(void)
 {
-	
-	
-	
 	OLED_RST_Set();
 	
-	OLED_WR_Byte(0xAE,OLED_CMD);//--turn off oled panel
-	OLED_WR_Byte(0x00,OLED_CMD);//---set low column address
-	OLED_WR_Byte(0x10,OLED_CMD);//---set high column address
-	OLED_WR_Byte(0x40,OLED_CMD);//--set start line address  Set Mapping RAM Display Start Line (0x00~0x3F)
-	OLED_WR_Byte(0x81,OLED_CMD);//--set contrast control register
-	OLED_WR_Byte(0xCF,OLED_CMD);// Set SEG Output Current Brightness
-	OLED_WR_Byte(0xA1,OLED_CMD);//--Set SEG/Column Mapping     
-	OLED_WR_Byte(0xC8,OLED_CMD);//Set COM/Row Scan Direction  
-	OLED_WR_Byte(0xA6,OLED_CMD);//--set normal display
-	OLED_WR_Byte(0xA8,OLED_CMD);//--set multiplex ratio(1 to 64)
-	OLED_WR_Byte(0x3f,OLED_CMD);//--1/64 duty
-	OLED_WR_Byte(0xD3,OLED_CMD);//-set display offset	Shift Mapping RAM Counter (0x00~0x3F)
-	OLED_WR_Byte(0x00,OLED_CMD);//-not offset
-	OLED_WR_Byte(0xd5,OLED_CMD);//--set display clock divide ratio/oscillator frequency
-	OLED_WR_Byte(0x80,OLED_CMD);//--set divide ratio, Set Clock as 100 Frames/Sec
-	OLED_WR_Byte(0xD9,OLED_CMD);//--set pre-charge period
-	OLED_WR_Byte(0xF1,OLED_CMD);//Set Pre-Charge as 15 Clocks & Discharge as 1 Clock
-	OLED_WR_Byte(0xDA,OLED_CMD);//--set com pins hardware configuration
-	OLED_WR_Byte(0x12,OLED_CMD);
-	OLED_WR_Byte(0xDB,OLED_CMD);//--set vcomh
-	OLED_WR_Byte(0x40,OLED_CMD);//Set VCOM Deselect Level
-	OLED_WR_Byte(0x20,OLED_CMD);//-Set Page Addressing Mode (0x00/0x01/0x02)
-	OLED_WR_Byte(0x02,OLED_CMD);//
-	OLED_WR_Byte(0x8D,OLED_CMD);//--set Charge Pump enable/disable
-	OLED_WR_Byte(0x14,OLED_CMD);//--set(0x10) disable
-	OLED_WR_Byte(0xA4,OLED_CMD);// Disable Entire Display On (0xa4/0xa5)
-	OLED_WR_Byte(0xA6,OLED_CMD);// Disable Inverse Display On (0xa6/a7) 
-	OLED_WR_Byte(0xAF,OLED_CMD);
+	OLED_BusBegin();                    //整个初始化序列一次发完
+	OLED_BusWrite(OLED_CMD,OLED_InitCmd,sizeof(OLED_InitCmd));
+	OLED_BusEnd();
 	OLED_Clear();
-}
\ No newline at end of file
+}
@@ -4,6 +4,8 @@
 
 // Include necessary standard libraries
 #include "main.h"
+#include "Plot.h"
+#include "Scope.h"
 
 #define OLED_RST_Clr() PINS_GPIO_WritePin(GPIOB,0,0)//RES
 #define OLED_RST_Set() PINS_GPIO_WritePin(GPIOB,0,1)
@@ -17,6 +19,61 @@
 #define OLED_CMD  0
 #define OLED_DATA 1
 
+#ifndef OLED_PAGE_MODE
+#define OLED_PAGE_MODE 0     //1: 两页(256字节)的页缓冲，每帧的画图命令先录进显示列表，再逐页回放发送，省下整帧缓冲、第二块缓冲和影子缓冲  0: 整帧缓冲
+#endif
+#ifndef OLED_LIST_SIZE
+#define OLED_LIST_SIZE 768   //页模式显示列表的大小(字节)，OLED_List.max_need是实际用过的最多字节数
+#endif
+
+#if OLED_PAGE_MODE
+#define OLED_FLUSH_DMA 0     //页缓冲只能逐页阻塞发送
+#else
+#define OLED_FLUSH_DMA 1     //1: 整帧缓冲通过DMA一次发出  0: 使用u8g2_SendBuffer逐行发送
+#endif
+
+#ifndef OLED_MIRROR
+#define OLED_MIRROR 0        //1: 屏上变了的tile压缩后从UART1发出去，PC上用tools/mirror.py看(和PRINTF共用UART1，最多每MIRROR_PERIOD ms一包，发送期间PRINTF的字会丢)
+#endif
+#define OLED_MIRROR_UART 1
+#if OLED_MIRROR && OLED_PAGE_MODE
+#error "OLED_MIRROR要和影子缓冲比较，不能用在OLED_PAGE_MODE"
+#endif
+
+#define OLED_TX_SIZE    32   //批量发送缓冲，命令和短数据先攒在这里，更长的数据直接发
+#define OLED_TX_TIMEOUT 100  //一次阻塞SPI发送的超时 ms
+
+typedef void (*OLED_FlushCallback)(void);   //DMA发送完成回调，在SPI中断里调用
+
+#define OLED_PRESENT_BUSY 0  //上一帧还在发送，这一帧没有提交，调用者可以跳过或合并到下一帧
+#define OLED_PRESENT_OK   1  //这一帧已交给DMA，u8g2已切到另一块缓冲，可以直接画下一帧
+
+#define OLED_PLOT_PER_COL 5  //电流曲线每列的样本数，Acq每40ms一个样本，一列200ms，整张图约18秒
+#define OLED_PLOT_CHS     3  //曲线界面上下键能切的电流通道数(Acq的通道0~2，和Current[3]对应)
+#define OLED_SCOPE_TRIG   SCOPE_RISE         //曲线界面OK键抓一次: 电流升过这一路设定的最大值就触发
+#define OLED_SCOPE_PRE    (SCOPE_DEPTH/4)    //触发前留的样本数，其余是触发后的
+
+#define OLED_FPS    30       //OLED_Task的最高帧率，没有输入、新数据和动画时不重画
+
+#define OLED_HW_SCROLL 1     //1: 主菜单图标上下切换，用SSD1306的显示起始行滚动，动画每帧只发新露出来的几页  0: 左右切换，每帧重发整排图标
+
+#ifndef OLED_DEBUG
+#define OLED_DEBUG  0        //1: 菜单里的按键/位置调试信息从串口打出来(会拖慢每一帧)
+#endif
+#if OLED_DEBUG
+#define OLED_LOG(...) PRINTF(__VA_ARGS__)
+#else
+#define OLED_LOG(...) ((void)0)
+#endif
+
+#define OLED_FONT_SUBSET  1  //1: 只含界面用到的字的子集字库，Keil编译前由tools/fontsubset.py生成u8g2_font_ui.c  0: 完整的wqy12字库
+#if OLED_FONT_SUBSET
+extern const uint8_t u8g2_font_wqy12_t_ui[];
+#define OLED_FONT u8g2_font_wqy12_t_ui
+#else
+#define OLED_FONT u8g2_font_wqy12_t_chinese3
+#endif
+
 typedef struct 
 {
     signed int min;
@@ -26,10 +83,28 @@ typedef struct
 
 
 extern unsigned char Lin_buff[3][10];
+extern Plot_t OLED_Plot;
+extern uint8_t OLED_PlotCh;
+extern Scope_t OLED_Scope;
 
 void OLED_Init(void);
+void OLED_BusBegin(void);
+void OLED_BusWrite(unsigned char dc,const uint8_t *dat,uint16_t len);
+void OLED_BusEnd(void);
+uint8_t u8x8_byte_YTM_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+void OLED_DMA_Init(void);
+unsigned char OLED_FlushDMA(u8g2_t *u8g2,OLED_FlushCallback done);
+unsigned char OLED_FlushBusy(void);
+void OLED_FlushWait(void);
+#if !OLED_PAGE_MODE
+unsigned char OLED_Present(u8g2_t *u8g2);
+#endif
 void u8g2_init(void);
 void  Menu_Show(void);
+void OLED_RequestRedraw(void);
+void OLED_ShowScope(Scope_t *s);
+unsigned char OLED_Task(void);
+unsigned char OLED_Export(void);
 
 
 #endif 
\ No newline at end of file
@@ -48,12 +48,19 @@
 
 /* Private function declare --------------------------------------------------*/
 /* USER CODE BEGIN PFDC */
-AutoFox_INA226 Ina226;
-const uint8_t INA226_IC2_ADDRESS = 0x40;
-const double SHUNT_RESISTOR_OHMS = 0.01;
-const double aMaxCurrent_AMPS = 5.0;
-double Current_vlue;
-unsigned char Currflag = 0;
+//三路电流各一个INA226: 地址 分流电阻(微欧) 量程(uA) 平均次数 转换时间 读的间隔
+//16次平均 1.1ms+1.1ms 约35ms出一个新值，间隔0就是每个新值读一次(40ms)
+static const Acq_Config_t Ina226_Config[ACQ_DEVS] = {
+    {0x40,10000,5000000,2,4,0},     //0.01欧 5A，电流LSB 153uA
+    {0x41,10000,5000000,2,4,0},
+    {0x44,10000,5000000,2,4,0},
+};
+int32_t Current_vlue;               //曲线通道(OLED_PlotCh)的电流 uA
+int32_t Current_Chan[ACQ_DEVS];     //每一路最新的电流 uA，曲线界面切通道时大数字先显示它
+#if OLED_PLOT_CHS > ACQ_DEVS
+#error "曲线能切的通道数不能超过ACQ_DEVS"
+#endif
+Acq_t Ina226_Acq;                   //电流的中断采集，由pTMR通道0定时或INA226的ALERT启动
 /* USER CODE END PFDC */
 static void Board_Init(void);
 
@@ -61,6 +68,9 @@ static void Board_Init(void);
 /* USER CODE BEGIN 0 */
 void User_Init(void);
 void pTMR0_IRQHandler(void);
+#if ACQ_ALERT
+void GPIO_IRQHandler(void);
+#endif
 void ADC0_IRQHandler(void);
  
 /* USER CODE END 0 */
@@ -73,7 +83,8 @@ void ADC0_IRQHandler(void);
 int main(void)
 {
     /* USER CODE BEGIN 1 */
-    
+    unsigned char ret;
+    Acq_Sample_t s;
     /* USER CODE END 1 */ 
     Board_Init();
     /* USER CODE BEGIN 2 */
@@ -91,12 +102,38 @@ int main(void)
         /* USER CODE BEGIN 3 */
        
       
-        Menu_Show();
-        if(Currflag)
+        ret = OLED_Task();              //只在有输入、新数据或动画时重画，帧率不超过OLED_FPS
+        if(OLED_Scope.state == SCOPE_ARM && !Ina226_Acq.burst)
+        {
+            if(!Acq_BurstStart(&Ina226_Acq,OLED_PlotCh,&OLED_Scope))   //曲线通道切到140us突发读
+                Scope_Stop(&OLED_Scope);
+        }
+        if(Ina226_Acq.burst && OLED_Scope.state != SCOPE_PRE && OLED_Scope.state != SCOPE_POST)
         {
-            Current_vlue = AutoFox_INA226_GetCurrent_uA(&Ina226)/1000.0;
-            Currflag = 0;
+            Acq_BurstStop(&Ina226_Acq);  //抓完了或者被停掉，恢复轮询
+            if(OLED_Scope.state == SCOPE_DONE)
+                OLED_ShowScope(&OLED_Scope);
+            OLED_RequestRedraw();
+            ret = 1;
         }
+        while(Acq_Get(&Ina226_Acq,&s))  //I2C中断里读好的样本，曲线一列凑齐了才重画
+        {
+            Current_Chan[s.ch] = s.value;
+            if(s.ch != OLED_PlotCh)
+                continue;
+            Current_vlue = s.value;
+            if(OLED_Scope.state != SCOPE_IDLE)
+                continue;               //抓到的波形还在屏上时曲线不动
+            if(Plot_Add(&OLED_Plot,s.value))
+            {
+                OLED_RequestRedraw();
+                ret = 1;
+            }
+        }
+        if(OLED_Export())               //抓到的波形CSV每轮打几行，打完之前不睡
+            ret = 1;
+        if(ret == 0)
+            __WFI();                    //这一轮没事做，睡到下一个中断(pTMR/ADC/SysTick 1ms)
         // Key_Work();
         // I2C_DRV_MasterReceiveDataBlocking(1, g_at24c02_rxData, 7, true, 1000);
     
@@ -111,13 +148,15 @@ static void Board_Init(void)
     pTMR_DRV_Init(0,&PTMR_Config);
     pTMR_DRV_InitChannel(0,0,&ptmr_channel_0);
     pTMR_DRV_InitChannel(0,1,&ptmr_channel_1);
+    pTMR_DRV_InitChannel(0,2,&ptmr_channel_2);
     PINS_DRV_Init(NUM_OF_CONFIGURED_PINS0,g_pin_mux_InitConfigArr0);
+    DMA_DRV_Init(&dmaState,&dmaController_InitConfig,dmaChnState,dmaChnConfigArray,NUM_OF_CONFIGURED_DMA_CHANNEL);
     SPI_DRV_MasterInit(2,&spi_MasterConfig0_State,&spi_MasterConfig0);
     UTILITY_PRINT_Init();
     LIN_DRV_Init(0,&lin_config0,&lin_config0_State);
     ADC_DRV_ConfigConverter(0,&adc_config0);
-    I2C_DRV_MasterInit(1,&I2C_MasterConfig0,&I2C_MasterConfig0_State);
     I2C_DRV_MasterInit(1,&I2C_MasterConfig1,&I2C_MasterConfig1_State);
+    I2C_DRV_MasterInit(1,&I2C_MasterConfig0,&I2C_MasterConfig0_State);   //同一个实例后初始化的生效，INA226的配置(带采集回调)放最后
 }
 
 /* USER CODE BEGIN 4 */
@@ -132,8 +171,8 @@ void User_Init(void)
     
     OLED_Init(); 
     u8g2_init();
-    I2C_DRV_MasterSetSlaveAddr(1,I2C_MasterConfig0.slaveAddress,I2C_MasterConfig0.is10bitAddr);
-    AutoFox_INA226_Init(&Ina226,INA226_IC2_ADDRESS,SHUNT_RESISTOR_OHMS,aMaxCurrent_AMPS);
+    OLED_DMA_Init();
+    Acq_Init(&Ina226_Acq,Ina226_Config,ACQ_DEVS);   //探测和配置每个INA226，之后I2C1归采集用，不能再调AutoFox_INA226_xxx的阻塞读写
 //    I2C_DRV_MasterSendDataBlocking(1,&a,1,false,1000);  
 }
 
@@ -145,14 +184,19 @@ void pTMR0_IRQHandler(void)
         /* Note: Debug output inserted into interrupt routine for demo clarity. Might introduce delay. */
         ADC_DRV_Start(ADC_INST);
         Botton_Scan();
+        Acq_Tick(&Ina226_Acq);
 
         // PRINTF("channel value x = %d  y = %d\n", AdcData[0], AdcData[1]);
     }
+    if (pTMR_DRV_GetInterruptFlagTimerChannels(0, ACQ_BURST_CH))
+    {
+        pTMR_DRV_ClearInterruptFlagTimerChannels(0, ACQ_BURST_CH);
+        Acq_BurstTick(&Ina226_Acq);     //突发抓取时每140us读一次
+    }
     if (pTMR_DRV_GetInterruptFlagTimerChannels(0, 1))
     {
         pTMR_DRV_ClearInterruptFlagTimerChannels(0, 1);
         Potenmeter();
-        Currflag = 1; 
         // PRINTF("%d \r\n",INA226_Read2Byte(Current_Reg)) ;
         /* Note: Debug output inserted into interrupt routine for demo clarity. Might introduce delay. */
         
@@ -161,6 +205,17 @@ void pTMR0_IRQHandler(void)
 
 }
 
+#if ACQ_ALERT
+void GPIO_IRQHandler(void)
+{
+    if(PINS_DRV_GetPortIntFlag(ACQ_ALERT_GPIO) & (1U << ACQ_ALERT_PIN))
+    {
+        PINS_DRV_ClearPinIntFlagCmd(ACQ_ALERT_GPIO,ACQ_ALERT_PIN);
+        Acq_Alert(&Ina226_Acq);         //有INA226转换完成，读新值
+    }
+}
+#endif
+
 void ADC0_IRQHandler(void)
 {
     ADC_DRV_ClearEoseqFlagCmd(0);
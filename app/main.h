@@ -9,11 +9,13 @@
 #include "Joystick.h"
 // #include "Ina226.h"
 #include "Autofox_INA226_c.h"
+#include "Acq.h"
 
 #define SPI_INST         (2)
 #define SPI_TRANS_LENGTH (8)
 #define PTMR_INST 0
 
-extern double Current_vlue;
+extern int32_t Current_vlue;
+extern int32_t Current_Chan[ACQ_DEVS];
 
 #endif
\ No newline at end of file
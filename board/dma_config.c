@@ -26,7 +26,7 @@
 
 const dma_channel_config_t dma_config0 = {
     .virtChnConfig=0,
-    .source=DMA_REQ_DISABLED,
+    .source=DMA_REQ_SPI2_TX,
     .callback=NULL,
     .callbackParam=NULL,
 };
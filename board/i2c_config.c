@@ -33,7 +33,7 @@ const i2c_master_user_config_t I2C_MasterConfig0 = {
     .transferType=I2C_USING_INTERRUPTS,
     .baudRate=400000,
     .dmaChannel=0,
-    .masterCallback=NULL,
+    .masterCallback=Acq_I2cCallback,
     .callbackParam=NULL,
 };
 /*I2C_MasterConfig1*/
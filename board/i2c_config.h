@@ -31,6 +31,7 @@
 /*I2C_MasterConfig0*/
 extern i2c_master_state_t I2C_MasterConfig0_State;
 extern const i2c_master_user_config_t I2C_MasterConfig0;
+extern void Acq_I2cCallback(i2c_master_event_t event,void *userData);
 /*I2C_MasterConfig1*/
 extern i2c_master_state_t I2C_MasterConfig1_State;
 extern const i2c_master_user_config_t I2C_MasterConfig1;
@@ -31,6 +31,12 @@ const ptmr_user_channel_config_t ptmr_channel_1={
     .chainChannel=false,
     .isInterruptEnabled=true,
 };
+const ptmr_user_channel_config_t ptmr_channel_2={
+    .periodUnits=pTMR_PERIOD_UNITS_MICROSECONDS,
+    .period=140,
+    .chainChannel=false,
+    .isInterruptEnabled=true,
+};
 
 const ptmr_user_config_t PTMR_Config={
     .enableRunInDebug=false,
@@ -29,6 +29,7 @@
 
 extern const ptmr_user_channel_config_t ptmr_channel_0;
 extern const ptmr_user_channel_config_t ptmr_channel_1;
+extern const ptmr_user_channel_config_t ptmr_channel_2;
 extern const ptmr_user_config_t PTMR_Config;
 
 #endif
\ No newline at end of file
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""
+从u8g2字库里只取界面用到的字，生成一个小字库(u8g2字库格式)
+
+  python tools/fontsubset.py 字库.c 字库名 新字库名 输出.c 界面源文件...
+
+  python tools/fontsubset.py Hardware/U8g2/u8g2_fonts.c u8g2_font_wqy12_t_chinese3 \
+      u8g2_font_wqy12_t_ui Hardware/u8g2_font_ui.c Hardware/u8g2_d.c
+
+界面源文件里所有字符串常量中的非ASCII字都会放进新字库，ASCII 32~126 全部保留
+(sprintf出来的数字、字母不在字符串常量里)。字库里没有的字会打印警告。
+Keil的 Before Build 会运行它，输出文件内容没变时不重写，避免每次都重新编译。
+"""
+import re
+import sys
+
+HEADER_SIZE = 23
+
+
+def c_unescape(body):
+    """C字符串常量(不含引号)转成字节"""
+    out = bytearray()
+    i = 0
+    simple = {'n': 10, 't': 9, 'r': 13, 'a': 7, 'b': 8, 'f': 12, 'v': 11,
+              '\\': 92, '"': 34, "'": 39, '?': 63}
+    while i < len(body):
+        c = body[i]
+        if c != '\\':
+            out += c.encode('latin-1')
+            i += 1
+            continue
+        i += 1
+        c = body[i]
+        if c in '01234567':
+            j = i
+            while j < len(body) and j < i + 3 and body[j] in '01234567':
+                j += 1
+            out.append(int(body[i:j], 8) & 0xff)
+            i = j
+        elif c == 'x':
+            j = i + 1
+            while j < len(body) and body[j] in '0123456789abcdefABCDEF':
+                j += 1
+            out.append(int(body[i + 1:j], 16) & 0xff)
+            i = j
+        else:
+            out.append(simple[c])
+            i += 1
+    return bytes(out)
+
+
+def read_font(path, name):
+    """在C文件里找 name 的定义，支持u8g2的字符串写法和 {1,2,3} 数组写法"""
+    text = open(path, encoding='latin-1').read()
+    m = re.search(r'\b' + re.escape(name) + r'\s*\[[^\]]*\][^=;]*=\s*', text)
+    if m is None:
+        sys.exit('%s: %s not found' % (path, name))
+    rest = text[m.end():]
+    if rest.startswith('{'):
+        body = rest[1:rest.index('}')]
+        return bytes(int(v, 0) & 0xff for v in re.findall(r'0x[0-9a-fA-F]+|\d+', body))
+    end = re.search(r';', re.sub(r'"(\\.|[^"\\])*"', lambda s: ' ' * len(s.group(0)), rest)).start()
+    return b''.join(c_unescape(s) for s in re.findall(r'"((?:\\.|[^"\\])*)"', rest[:end]))
+
+
+def word(font, pos):
+    return (font[pos] << 8) | font[pos + 1]
+
+
+def parse_glyphs(font):
+    """返回 {编码: 字形数据(不含编码和长度字节)}"""
+    glyphs = {}
+    pos = HEADER_SIZE
+    while font[pos + 1] != 0:
+        size = font[pos + 1]
+        glyphs[font[pos]] = font[pos + 2:pos + size]
+        pos += size
+    table = HEADER_SIZE + word(font, 21)
+    pos = table + word(font, table)     # 跳表第一项指向第一个unicode字形
+    while word(font, pos) != 0:
+        size = font[pos + 2]
+        glyphs[word(font, pos)] = font[pos + 3:pos + size]
+        pos += size
+    return glyphs
+
+
+def build_font(header, glyphs):
+    ascii_part = bytearray()
+    pos_A = pos_a = None
+    for e in sorted(k for k in glyphs if k < 256):
+        if pos_A is None and e >= ord('A'):
+            pos_A = len(ascii_part)
+        if pos_a is None and e >= ord('a'):
+            pos_a = len(ascii_part)
+        data = glyphs[e]
+        ascii_part += bytes([e, len(data) + 2]) + data
+    if pos_A is None:
+        pos_A = len(ascii_part)
+    if pos_a is None:
+        pos_a = len(ascii_part)
+    ascii_part += b'\0\0'
+
+    # 跳表只有一项: 字形从跳表后面开始，0xFFFF 覆盖所有编码
+    unicode_part = bytearray(b'\0\4\xff\xff')
+    for e in sorted(k for k in glyphs if k >= 256):
+        data = glyphs[e]
+        unicode_part += bytes([e >> 8, e & 0xff, len(data) + 3]) + data
+    unicode_part += b'\0\0'
+
+    h = bytearray(header)
+    h[0] = len(glyphs) & 0xff
+    h[17:19] = bytes([pos_A >> 8, pos_A & 0xff])
+    h[19:21] = bytes([pos_a >> 8, pos_a & 0xff])
+    h[21:23] = bytes([len(ascii_part) >> 8, len(ascii_part) & 0xff])
+    return bytes(h) + bytes(ascii_part) + bytes(unicode_part)
+
+
+def c_string(data):
+    lines = []
+    line = ''
+    octal = False
+    for b in data:
+        c = chr(b)
+        if 32 <= b < 127 and c not in '\\"?' and not (octal and c in '01234567'):
+            s = c
+            octal = False
+        else:
+            s = '\\%o' % b
+            octal = True
+        if len(line) + len(s) > 100:
+            lines.append('  "' + line + '"')
+            line = ''
+            octal = s.startswith('\\')
+        line += s
+    lines.append('  "' + line + '"')
+    return '\n'.join(lines)
+
+
+def ui_chars(paths):
+    chars = set()
+    for path in paths:
+        text = open(path, 'rb').read().decode('utf-8', 'replace')
+        for s in re.findall(r'"((?:\\.|[^"\\\n])*)"', text):
+            chars.update(c for c in s if ord(c) > 126)
+    return chars
+
+
+def main():
+    if len(sys.argv) < 6:
+        sys.exit(__doc__)
+    font_path, font_name, out_name, out_path = sys.argv[1:5]
+    sources = sys.argv[5:]
+
+    font = read_font(font_path, font_name)
+    glyphs = parse_glyphs(font)
+    chars = ui_chars(sources)
+    keep = {e: d for e, d in glyphs.items() if 32 <= e <= 126}
+    for c in sorted(chars):
+        if ord(c) in glyphs:
+            keep[ord(c)] = glyphs[ord(c)]
+        else:
+            print('fontsubset: warning: %s (U+%04X) not in %s' % (c, ord(c), font_name), file=sys.stderr)
+    subset = build_font(font[:HEADER_SIZE], keep)
+
+    used = ''.join(sorted(c for c in chars if ord(c) in glyphs))
+    out = ('/*\n'
+           '  generated by tools/fontsubset.py from %s, do not edit\n'
+           '  %d of %d glyphs, %d bytes (ASCII 32..126 + %s)\n'
+           '*/\n'
+           '#include "u8g2.h"\n\n'
+           'const uint8_t %s[%d] U8G2_FONT_SECTION("%s") = \n%s;\n'
+           % (font_name, len(keep), len(glyphs), len(subset), used,
+              out_name, len(subset), out_name, c_string(subset)))
+    try:
+        if open(out_path, encoding='utf-8').read() == out:
+            return
+    except OSError:
+        pass
+    with open(out_path, 'w', encoding='utf-8') as f:
+        f.write(out)
+    print('fontsubset: %s: %d glyphs, %d bytes' % (out_path, len(keep), len(subset)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,25 @@
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+//SSD1306模拟器的显存，格式和u8g2的缓冲一样: 8页 每页128字节 竖排低位在上
+extern uint8_t HOST_OledRam[8][128];
+extern uint8_t HOST_OledStartLine;   //显示起始行(0x40~0x7F)，屏幕第y行显示显存第(y+起始行)%64行
+
+//虚拟SPI的统计，DC高算数据，DC低算命令
+extern uint32_t HOST_SpiDataBytes;
+extern uint32_t HOST_SpiCmdBytes;
+extern uint32_t HOST_SpiTransfers;
+extern uint64_t HOST_SpiNs;          //花在SPI桩里的时间，从帧时间里扣掉
+
+extern FILE *HOST_UartFile;          //UART发出的字节(OLED_MIRROR的镜像包)写到这里，NULL就丢掉
+
+extern int HOST_Verbose;             //1: PRINTF输出到stderr
+
+extern uint32_t HOST_Ms;             //OSIF_GetMilliseconds返回的虚拟时钟，脚本每帧走1000/OLED_FPS ms
+
+uint64_t HOST_Ns(void);
+
+#endif
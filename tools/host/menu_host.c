@@ -0,0 +1,256 @@
+/*
+	Menu_Show 的主机测试程序: 测每帧画图时间和SPI字节数，截图和golden比较
+
+	menu_host [-v] [-u] [-s 脚本] [-g golden目录] [-o 输出目录] [-m 镜像文件]
+		-v  打开PRINTF输出(stderr)
+		-u  所有截图都重新写成golden
+		-m  UART发出的字节存到文件里(OLED_MIRROR=1编译时是屏幕镜像包，用tools/mirror.py解)
+
+	脚本每行一条命令，#后面是注释:
+		frames N                         跑N帧，每帧虚拟时钟走1000/OLED_FPS ms
+		key up|down|left|right|ok|back   置位PotenmeterFlag，下一帧Menu_Show处理
+		ain X Y                          摇杆ADC值 AINX AINY
+		sample V N                       N个电流样本V(uA)，每个样本走HOST_SAMPLE_MS，曲线一列凑齐了画一帧
+		shot NAME                        模拟器屏幕(显存按起始行转过)存成 输出目录/NAME.pbm 并和 golden目录/NAME.pbm 比较
+
+	每帧输出一行: 帧号 画图us SPI数据字节 SPI命令字节 SPI传输次数
+	画图us是Menu_Show的时间减去SPI桩的时间，只能拿来和主机上的其他版本比较
+	有截图对不上或者golden不存在时返回1，新截图要先用-u写成golden
+*/
+#include <stdlib.h>
+#include "main.h"
+#include "host.h"
+
+#define HOST_SAMPLE_MS 40               //和默认配置下Acq每个通道读的间隔一样，sample命令每个样本走这么多ms
+
+unsigned char PotenmeterFlag;
+uint32_t AINX = 2048, AINY = 2048;
+int32_t Current_vlue;
+int32_t Current_Chan[OLED_PLOT_CHS];
+
+static FILE *Pbm_File;
+static char Pbm_Text[128*64*2+64];
+static uint32_t Pbm_Len;
+
+static void Pbm_Out(const char *s)
+{
+	while(*s && Pbm_Len < sizeof(Pbm_Text)-1)
+		Pbm_Text[Pbm_Len++] = *s++;
+	Pbm_Text[Pbm_Len] = 0;
+}
+
+static char *Load_File(const char *name)
+{
+	FILE *f = fopen(name,"rb");
+	char *buf;
+	long len;
+	if(f == NULL)
+		return NULL;
+	fseek(f,0,SEEK_END);
+	len = ftell(f);
+	fseek(f,0,SEEK_SET);
+	buf = malloc(len+1);
+	len = (long)fread(buf,1,len,f);
+	buf[len] = 0;
+	fclose(f);
+	return buf;
+}
+
+static void Save_File(const char *name,const char *text)
+{
+	Pbm_File = fopen(name,"wb");
+	if(Pbm_File == NULL)
+	{
+		fprintf(stderr,"can't write %s\n",name);
+		exit(2);
+	}
+	fputs(text,Pbm_File);
+	fclose(Pbm_File);
+}
+
+//跳过P1头，只比较像素，返回不同的像素数
+static int Pbm_Diff(const char *a,const char *b)
+{
+	int i,diff = 0;
+	for(i=0;i<3;i++)
+	{
+		while(*a && *a != '\n') a++;
+		while(*b && *b != '\n') b++;
+		if(*a) a++;
+		if(*b) b++;
+	}
+	for(;;)
+	{
+		while(*a && *a != '0' && *a != '1') a++;
+		while(*b && *b != '0' && *b != '1') b++;
+		if(*a == 0 || *b == 0)
+			return (*a == *b) ? diff : diff+1;
+		if(*a != *b)
+			diff++;
+		a++;
+		b++;
+	}
+}
+
+static int Shot(const char *name,const char *golden_dir,const char *out_dir,int update)
+{
+	char path[512];
+	char *golden;
+	int diff,x,y,r;
+	static uint8_t screen[8][128];
+
+	//屏幕第y行是显存第(y+起始行)%64行
+	memset(screen,0,sizeof(screen));
+	for(y=0;y<64;y++)
+	{
+		r = (y+HOST_OledStartLine)&63;
+		for(x=0;x<128;x++)
+			if(HOST_OledRam[r>>3][x] & (1<<(r&7)))
+				screen[y>>3][x] |= 1<<(y&7);
+	}
+	Pbm_Len = 0;
+	u8x8_capture_write_pbm_pre(16,8,Pbm_Out);
+	u8x8_capture_write_pbm_buffer(&screen[0][0],16,8,u8x8_capture_get_pixel_1,Pbm_Out);
+	snprintf(path,sizeof(path),"%s/%s.pbm",out_dir,name);
+	Save_File(path,Pbm_Text);
+
+	snprintf(path,sizeof(path),"%s/%s.pbm",golden_dir,name);
+	if(update)
+	{
+		Save_File(path,Pbm_Text);
+		printf("# shot %s: new golden\n",name);
+		return 0;
+	}
+	golden = Load_File(path);
+	if(golden == NULL)                  //没有golden算失败，不然少提交一张图也能通过
+	{
+		printf("# shot %s: no golden %s\n",name,path);
+		return 1;
+	}
+	diff = Pbm_Diff(golden,Pbm_Text);
+	free(golden);
+	printf("# shot %s: %s (%d pixel)\n",name,diff ? "DIFF" : "ok",diff);
+	return diff != 0;
+}
+
+static unsigned char Key_Bit(const char *key)
+{
+	static const char *names[] = {"up","down","left","right","ok","back"};
+	unsigned char i;
+	for(i=0;i<6;i++)
+		if(strcmp(key,names[i]) == 0)
+			return 1<<i;
+	fprintf(stderr,"unknown key %s\n",key);
+	exit(2);
+}
+
+int main(int argc,char **argv)
+{
+	const char *script = "menu.script";
+	const char *golden_dir = "golden";
+	const char *out_dir = "out";
+	int update = 0,fail = 0,i;
+	char line[256],arg[64];
+	FILE *f;
+	uint32_t frame = 0,n,x,y;
+	int v;
+	uint64_t draw_ns,draw_sum = 0,draw_max = 0;
+	uint32_t data_sum = 0,cmd_sum = 0,xfer_sum = 0;
+
+	for(i=1;i<argc;i++)
+	{
+		if(strcmp(argv[i],"-v") == 0) HOST_Verbose = 1;
+		else if(strcmp(argv[i],"-u") == 0) update = 1;
+		else if(strcmp(argv[i],"-s") == 0 && i+1 < argc) script = argv[++i];
+		else if(strcmp(argv[i],"-g") == 0 && i+1 < argc) golden_dir = argv[++i];
+		else if(strcmp(argv[i],"-o") == 0 && i+1 < argc) out_dir = argv[++i];
+		else if(strcmp(argv[i],"-m") == 0 && i+1 < argc)
+		{
+			HOST_UartFile = fopen(argv[++i],"wb");
+			if(HOST_UartFile == NULL)
+			{
+				fprintf(stderr,"can't write %s\n",argv[i]);
+				return 2;
+			}
+		}
+		else
+		{
+			fprintf(stderr,"usage: %s [-v] [-u] [-s script] [-g golden_dir] [-o out_dir] [-m mirror_file]\n",argv[0]);
+			return 2;
+		}
+	}
+	f = fopen(script,"r");
+	if(f == NULL)
+	{
+		fprintf(stderr,"can't open %s\n",script);
+		return 2;
+	}
+
+	//和User_Init里的显示部分一样
+	OLED_Init();
+	u8g2_init();
+	OLED_DMA_Init();
+
+	printf("# frame draw_us spi_data spi_cmd spi_xfer\n");
+	while(fgets(line,sizeof(line),f) != NULL)
+	{
+		char *p = strchr(line,'#');
+		if(p != NULL)
+			*p = 0;
+		if(sscanf(line,"frames %u",&n) == 1)
+		{
+			while(n--)
+			{
+				uint32_t data0 = HOST_SpiDataBytes,cmd0 = HOST_SpiCmdBytes,xfer0 = HOST_SpiTransfers;
+				uint64_t spi0 = HOST_SpiNs,t0;
+				HOST_Ms += 1000/OLED_FPS;
+				t0 = HOST_Ns();
+				Menu_Show();
+				draw_ns = HOST_Ns()-t0-(HOST_SpiNs-spi0);
+				draw_sum += draw_ns;
+				draw_max = draw_ns > draw_max ? draw_ns : draw_max;
+				data_sum += HOST_SpiDataBytes-data0;
+				cmd_sum += HOST_SpiCmdBytes-cmd0;
+				xfer_sum += HOST_SpiTransfers-xfer0;
+				printf("%u %.1f %u %u %u\n",frame,draw_ns/1000.0,HOST_SpiDataBytes-data0,HOST_SpiCmdBytes-cmd0,HOST_SpiTransfers-xfer0);
+				frame++;
+			}
+		}
+		else if(sscanf(line,"key %63s",arg) == 1)
+			PotenmeterFlag |= Key_Bit(arg);
+		else if(sscanf(line,"ain %u %u",&x,&y) == 2)
+		{
+			AINX = x;
+			AINY = y;
+		}
+		else if(sscanf(line,"sample %d %u",&v,&n) == 2)
+		{
+			while(n--)                      //和主循环取Acq样本一样，曲线一列凑齐了才画一帧
+			{
+				Current_vlue = v;
+				HOST_Ms += HOST_SAMPLE_MS;
+				if(Plot_Add(&OLED_Plot,v))
+				{
+					OLED_RequestRedraw();
+					Menu_Show();
+					frame++;
+				}
+			}
+		}
+		else if(sscanf(line,"shot %63s",arg) == 1)
+			fail |= Shot(arg,golden_dir,out_dir,update);
+		else if(sscanf(line,"%63s",arg) == 1)
+		{
+			fprintf(stderr,"bad line: %s",line);
+			return 2;
+		}
+	}
+	fclose(f);
+	if(HOST_UartFile != NULL)
+		fclose(HOST_UartFile);
+
+	if(frame)
+		printf("# frames %u draw_us avg %.1f max %.1f spi_data %u (%.1f/frame) spi_cmd %u spi_xfer %u\n",
+			frame,draw_sum/1000.0/frame,draw_max/1000.0,data_sum,(double)data_sum/frame,cmd_sum,xfer_sum);
+	return fail;
+}
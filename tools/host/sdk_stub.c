@@ -0,0 +1,189 @@
+/*
+	主机上的SDK桩: GPIO记住电平，SPI把字节交给SSD1306模拟器，DMA传输当场完成并回调
+*/
+#include <stdarg.h>
+#include <time.h>
+#include "main.h"
+#include "host.h"
+
+GPIO_Type HOST_GPIO[3];
+
+uint8_t HOST_OledRam[8][128];
+uint8_t HOST_OledStartLine;
+uint32_t HOST_SpiDataBytes;
+uint32_t HOST_SpiCmdBytes;
+uint32_t HOST_SpiTransfers;
+uint64_t HOST_SpiNs;
+FILE *HOST_UartFile = NULL;
+int HOST_Verbose = 0;
+uint32_t HOST_Ms;
+
+const spi_master_config_t spi_MasterConfig0 = {SPI_USING_INTERRUPTS, 0, 0, NULL, NULL};
+static const dma_channel_config_t dmaChnConfig0 = {0};
+const dma_channel_config_t * const dmaChnConfigArray[] = {&dmaChnConfig0};
+
+static spi_master_config_t HOST_SpiConfig;
+
+/*
+	SSD1306模拟器，只处理u8g2和OLED_Init用到的寻址命令
+	0x21/0x22 设置列/页窗口，0xB0~0xB7 和 0x00~0x1F 是页寻址模式的页和列，0x40~0x7F 是显示起始行
+*/
+static uint8_t Oled_Col,Oled_Page;
+static uint8_t Oled_Col0 = 0,Oled_Col1 = 127,Oled_Page0 = 0,Oled_Page1 = 7;
+static uint8_t Oled_Cmd[3];
+static uint8_t Oled_CmdCnt = 0;
+
+static uint8_t Oled_CmdLen(uint8_t cmd)
+{
+	if(cmd == 0x21 || cmd == 0x22)
+		return 3;
+	if(cmd == 0x20 || cmd == 0x81 || cmd == 0x8D || cmd == 0xA8 || cmd == 0xD3 || cmd == 0xD5 || cmd == 0xD9 || cmd == 0xDA || cmd == 0xDB)
+		return 2;
+	return 1;
+}
+
+static void Oled_WriteCmd(uint8_t b)
+{
+	uint8_t c;
+	Oled_Cmd[Oled_CmdCnt++] = b;
+	if(Oled_CmdCnt < Oled_CmdLen(Oled_Cmd[0]))
+		return;
+	Oled_CmdCnt = 0;
+	c = Oled_Cmd[0];
+	if(c < 0x10)
+		Oled_Col = (Oled_Col&0xF0)|c;
+	else if(c < 0x20)
+		Oled_Col = (Oled_Col&0x0F)|((c&0x0F)<<4);
+	else if(c >= 0x40 && c <= 0x7F)
+		HOST_OledStartLine = c&0x3F;
+	else if(c >= 0xB0 && c <= 0xB7)
+		Oled_Page = c&0x07;
+	else if(c == 0x21)
+	{
+		Oled_Col0 = Oled_Cmd[1]&0x7F;
+		Oled_Col1 = Oled_Cmd[2]&0x7F;
+		Oled_Col = Oled_Col0;
+	}
+	else if(c == 0x22)
+	{
+		Oled_Page0 = Oled_Cmd[1]&0x07;
+		Oled_Page1 = Oled_Cmd[2]&0x07;
+		Oled_Page = Oled_Page0;
+	}
+}
+
+static void Oled_WriteData(uint8_t b)
+{
+	HOST_OledRam[Oled_Page&7][Oled_Col&127] = b;
+	Oled_Col++;
+	if(Oled_Col > Oled_Col1)
+	{
+		Oled_Col = Oled_Col0;
+		Oled_Page++;
+		if(Oled_Page > Oled_Page1)
+			Oled_Page = Oled_Page0;
+	}
+}
+
+uint64_t HOST_Ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return (uint64_t)ts.tv_sec*1000000000u+ts.tv_nsec;
+}
+
+int HOST_Printf(const char *fmt, ...)
+{
+	va_list ap;
+	int n = 0;
+	if(HOST_Verbose)
+	{
+		va_start(ap,fmt);
+		n = vfprintf(stderr,fmt,ap);
+		va_end(ap);
+	}
+	return n;
+}
+
+void PINS_GPIO_WritePin(GPIO_Type *base, uint32_t pin, uint32_t value)
+{
+	if(value)
+		base->pins |= 1u<<pin;
+	else
+		base->pins &= ~(1u<<pin);
+}
+
+uint32_t PINS_GPIO_ReadPins(const GPIO_Type *base)
+{
+	return base->pins;
+}
+
+status_t SPI_DRV_MasterConfigureBus(uint32_t instance, const spi_master_config_t *spiConfig, uint32_t *calculatedBaudRate)
+{
+	(void)instance;
+	(void)calculatedBaudRate;
+	HOST_SpiConfig = *spiConfig;
+	return STATUS_SUCCESS;
+}
+
+status_t SPI_DRV_MasterTransferBlocking(uint32_t instance, const uint8_t *sendBuffer, uint8_t *receiveBuffer, uint16_t transferByteCount, uint32_t timeout)
+{
+	uint64_t t0 = HOST_Ns();
+	uint16_t i;
+	uint8_t dc = (GPIOA->pins>>6)&1;      //DC在PA6
+	(void)instance;
+	(void)receiveBuffer;
+	(void)timeout;
+	HOST_SpiTransfers++;
+	for(i=0;i<transferByteCount;i++)
+	{
+		if(dc)
+		{
+			Oled_WriteData(sendBuffer[i]);
+			HOST_SpiDataBytes++;
+		}
+		else
+		{
+			Oled_WriteCmd(sendBuffer[i]);
+			HOST_SpiCmdBytes++;
+		}
+	}
+	HOST_SpiNs += HOST_Ns()-t0;
+	if(HOST_SpiConfig.callback != NULL)   //和真驱动一样，阻塞发送结束也会回调
+		HOST_SpiConfig.callback(NULL,SPI_EVENT_END_TRANSFER,HOST_SpiConfig.callbackParam);
+	return STATUS_SUCCESS;
+}
+
+//主机上没有真正的异步，发送当场完成
+status_t SPI_DRV_MasterTransfer(uint32_t instance, const uint8_t *sendBuffer, uint8_t *receiveBuffer, uint16_t transferByteCount)
+{
+	return SPI_DRV_MasterTransferBlocking(instance,sendBuffer,receiveBuffer,transferByteCount,0);
+}
+
+//UART也是当场发完
+status_t UART_DRV_SendData(uint32_t instance, const uint8_t *txBuff, uint32_t txSize)
+{
+	(void)instance;
+	if(HOST_UartFile != NULL)
+		fwrite(txBuff,1,txSize,HOST_UartFile);
+	return STATUS_SUCCESS;
+}
+
+status_t UART_DRV_GetTransmitStatus(uint32_t instance, uint32_t *bytesRemaining)
+{
+	(void)instance;
+	if(bytesRemaining != NULL)
+		*bytesRemaining = 0;
+	return STATUS_SUCCESS;
+}
+
+void OSIF_TimeDelay(uint32_t delay)
+{
+	(void)delay;
+}
+
+//动画按这个时钟走，截图和机器快慢无关
+uint32_t OSIF_GetMilliseconds(void)
+{
+	return HOST_Ms;
+}
@@ -0,0 +1,89 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+/*
+	主机(Linux)上代替 app/main.h，只声明 u8g2_d.c 等显示代码用到的SDK接口
+	实现在 sdk_stub.c，SPI发出去的字节送进一个SSD1306模拟器
+*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "u8g2.h"
+
+typedef enum
+{
+    STATUS_SUCCESS = 0,
+    STATUS_ERROR   = 1,
+    STATUS_BUSY    = 2,
+    STATUS_TIMEOUT = 3
+} status_t;
+
+typedef struct
+{
+    uint32_t pins;
+} GPIO_Type;
+
+extern GPIO_Type HOST_GPIO[3];
+#define GPIOA (&HOST_GPIO[0])
+#define GPIOB (&HOST_GPIO[1])
+#define GPIOC (&HOST_GPIO[2])
+
+void PINS_GPIO_WritePin(GPIO_Type *base, uint32_t pin, uint32_t value);
+uint32_t PINS_GPIO_ReadPins(const GPIO_Type *base);
+
+typedef enum
+{
+    SPI_EVENT_END_TRANSFER = 0
+} spi_event_t;
+
+typedef enum
+{
+    SPI_USING_DMA = 0,
+    SPI_USING_INTERRUPTS
+} spi_transfer_type;
+
+typedef void (*spi_callback_t)(void *driverState, spi_event_t event, void *userData);
+
+typedef struct
+{
+    spi_transfer_type transferType;
+    uint8_t rxDMAChannel;
+    uint8_t txDMAChannel;
+    spi_callback_t callback;
+    void *callbackParam;
+} spi_master_config_t;
+
+typedef struct
+{
+    uint8_t virtChnConfig;
+} dma_channel_config_t;
+
+extern const spi_master_config_t spi_MasterConfig0;
+extern const dma_channel_config_t * const dmaChnConfigArray[];
+
+status_t SPI_DRV_MasterConfigureBus(uint32_t instance, const spi_master_config_t *spiConfig, uint32_t *calculatedBaudRate);
+status_t SPI_DRV_MasterTransfer(uint32_t instance, const uint8_t *sendBuffer, uint8_t *receiveBuffer, uint16_t transferByteCount);
+status_t SPI_DRV_MasterTransferBlocking(uint32_t instance, const uint8_t *sendBuffer, uint8_t *receiveBuffer, uint16_t transferByteCount, uint32_t timeout);
+
+status_t UART_DRV_SendData(uint32_t instance, const uint8_t *txBuff, uint32_t txSize);
+status_t UART_DRV_GetTransmitStatus(uint32_t instance, uint32_t *bytesRemaining);
+
+void OSIF_TimeDelay(uint32_t delay);
+uint32_t OSIF_GetMilliseconds(void);
+
+#define __NOP()
+#define PRINTF(...) HOST_Printf(__VA_ARGS__)
+int HOST_Printf(const char *fmt, ...);
+
+#include "u8g2_d.h"
+#include "Joystick.h"
+
+#define SPI_INST         (2)
+#define SPI_TRANS_LENGTH (8)
+#define PTMR_INST 0
+
+extern int32_t Current_vlue;
+extern int32_t Current_Chan[];          //长度OLED_PLOT_CHS，u8g2_d.h先包含本文件时还没定义
+
+#endif
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""
+主机测试用的假字库: 和 u8g2_font_wqy12_t_chinese3 同名、同样的字框，字形按编码算出来
+
+  python testfont.py 输出.c 界面源文件...
+
+  python testfont.py testfont.c ../../Hardware/u8g2_d.c
+
+真正的wqy12字库不在仓库里，golden/ 下的截图是用这个字库画的，谁来跑结果都一样。
+ASCII 32~126 和界面源文件字符串常量里的非ASCII字都有字形(和 fontsubset.py 取的字一样)，
+字形是按编码算出的点阵，不像字但每个字都不一样，字宽和字框按wqy12(ASCII 6点宽，汉字12点宽)。
+输出文件内容没变时不重写。
+"""
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+from fontsubset import build_font, c_string, ui_chars  # noqa: E402
+
+FONT_NAME = 'u8g2_font_wqy12_t_chinese3'
+
+# 各字段的位数: 0的游程 1的游程 宽 高 x y 步进
+BITS_0, BITS_1, BITS_W, BITS_H, BITS_X, BITS_Y, BITS_D = 4, 4, 4, 4, 2, 3, 5
+DESCENDERS = 'gjpqy,;'
+
+
+class BitWriter:
+    """u8g2字库的位流: 低位在前"""
+
+    def __init__(self):
+        self.data = bytearray()
+        self.pos = 0
+
+    def put(self, v, n):
+        for i in range(n):
+            if self.pos == 0:
+                self.data.append(0)
+            if (v >> i) & 1:
+                self.data[-1] |= 1 << self.pos
+            self.pos = (self.pos + 1) & 7
+
+
+def metrics(e):
+    """宽 高 x y(字形下沿相对基线) 步进"""
+    c = chr(e)
+    if e == 32:
+        return 0, 0, 0, 0, 6
+    if e > 126:
+        return 11, 11, 0, -1, 12
+    if c in DESCENDERS:
+        return 5, 9, 0, -2, 6
+    return 5, 8, 0, 0, 6
+
+
+def pixels(e, w, h):
+    """按编码算点阵，每个点用编码和位置做一次整数散列，约四成是黑点"""
+    out = []
+    for i in range(w * h):
+        v = (e * 2654435761 + i * 40503 + 0x9e37) & 0xffffffff
+        v ^= v >> 15
+        v = (v * 2246822519) & 0xffffffff
+        v ^= v >> 13
+        out.append(v % 5 < 2)
+    return out
+
+
+def glyph(e):
+    w, h, x, y, d = metrics(e)
+    b = BitWriter()
+    b.put(w, BITS_W)
+    b.put(h, BITS_H)
+    b.put(x + (1 << (BITS_X - 1)), BITS_X)
+    b.put(y + (1 << (BITS_Y - 1)), BITS_Y)
+    b.put(d + (1 << (BITS_D - 1)), BITS_D)
+    px = pixels(e, w, h)
+    i = 0
+    while i < len(px):        # 游程: 0的个数 1的个数，后面跟1位"不重复"
+        zeros = 0
+        while i < len(px) and not px[i] and zeros < (1 << BITS_0) - 1:
+            zeros += 1
+            i += 1
+        ones = 0
+        while i < len(px) and px[i] and ones < (1 << BITS_1) - 1:
+            ones += 1
+            i += 1
+        b.put(zeros, BITS_0)
+        b.put(ones, BITS_1)
+        b.put(0, 1)
+    return bytes(b.data)
+
+
+def header():
+    """build_font()填字数和三个起始位置，这里只给字框和位数"""
+    return bytes([0, 0, BITS_0, BITS_1, BITS_W, BITS_H, BITS_X, BITS_Y, BITS_D,
+                  12, 12, 0, (-2) & 0xff, 8, (-2) & 0xff, 10, (-2) & 0xff,
+                  0, 0, 0, 0, 0, 0])
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    out_path = sys.argv[1]
+    chars = ui_chars(sys.argv[2:])
+    codes = list(range(32, 127)) + sorted(ord(c) for c in chars)
+    font = build_font(header(), {e: glyph(e) for e in codes})
+
+    out = ('/*\n'
+           '  generated by tools/host/testfont.py, do not edit\n'
+           '  host test font, %d glyphs, %d bytes (ASCII 32..126 + %s)\n'
+           '*/\n'
+           '#include "u8g2.h"\n\n'
+           'const uint8_t %s[%d] U8G2_FONT_SECTION("%s") = \n%s;\n'
+           % (len(codes), len(font), ''.join(sorted(chars)),
+              FONT_NAME, len(font), FONT_NAME, c_string(font)))
+    try:
+        if open(out_path, encoding='utf-8').read() == out:
+            return
+    except OSError:
+        pass
+    with open(out_path, 'w', encoding='utf-8') as f:
+        f.write(out)
+    print('testfont: %s: %d glyphs, %d bytes' % (out_path, len(codes), len(font)))
+
+
+if __name__ == '__main__':
+    main()
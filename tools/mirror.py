@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""
+解OLED_MIRROR从UART1发出来的屏幕镜像包，在终端里显示屏幕，中间夹着的PRINTF文字照常打印
+
+  python tools/mirror.py [-b 波特率] [-p 输出.pbm] 串口|文件|-
+
+  python tools/mirror.py /dev/ttyUSB0
+  python tools/mirror.py -p out/mirror.pbm tools/host/out/mirror.bin
+
+串口默认115200，文件读完后显示最后一屏；-p 把最后一屏存成和menu_host截图一样的P1格式。
+包格式(Mirror.c): A5 5A 长度(2字节小端) 内容 校验(内容字节和取反)
+内容: 序号 显示起始行 {起始tile 个数 游程数据}...  tile = 页*16 + 列/8，每个tile 8字节
+游程: 控制字节c<0x80后面跟c+1个原样字节，c>=0x80后面1个字节重复c-0x80+3次
+"""
+import os
+import sys
+
+W = 128
+H = 64
+MAX_LEN = 1024          # 比MIRROR_TX_SIZE大就当作同步错了
+
+
+class Screen:
+    def __init__(self):
+        self.ram = bytearray(W * H // 8)   # 和SSD1306显存一样，8页 每页128字节
+        self.start = 0
+        self.seq = None
+        self.packets = 0
+        self.lost = 0
+        self.bad = 0
+
+    def packet(self, data):
+        seq, start = data[0], data[1]
+        if self.seq is not None and seq != (self.seq + 1) & 0xff:
+            self.lost += (seq - self.seq - 1) & 0xff
+            print('mirror: lost %d packet(s) before #%d' % ((seq - self.seq - 1) & 0xff, seq),
+                  file=sys.stderr)
+        self.seq = seq
+        self.start = start & 63
+        pos = 2
+        while pos + 2 <= len(data):
+            tile, n = data[pos], data[pos + 1]
+            out, pos = unrle(data, pos + 2, n * 8)
+            self.ram[tile * 8:tile * 8 + len(out)] = out
+        self.packets += 1
+
+    def pixel(self, x, y):
+        """屏幕第y行是显存第(y+起始行)%64行"""
+        r = (y + self.start) & 63
+        return self.ram[(r >> 3) * W + x] >> (r & 7) & 1
+
+    def text(self):
+        rows = []
+        for y in range(0, H, 2):
+            rows.append(''.join(' ▀▄█'[self.pixel(x, y) | self.pixel(x, y + 1) << 1]
+                                for x in range(W)))
+        return '\n'.join(rows)
+
+    def pbm(self):
+        rows = [''.join(str(self.pixel(x, y)) for x in range(W)) for y in range(H)]
+        return 'P1\n%d\n%d\n%s\n' % (W, H, '\n'.join(rows))
+
+
+def unrle(data, pos, count):
+    out = bytearray()
+    while len(out) < count and pos < len(data):
+        c = data[pos]
+        if c < 0x80:
+            out += data[pos + 1:pos + 2 + c]
+            pos += 2 + c
+        else:
+            out += bytes([data[pos + 1]]) * (c - 0x80 + 3)
+            pos += 2
+    return out[:count], pos
+
+
+class Parser:
+    """从字节流里找出镜像包，其余字节当作PRINTF的文字"""
+
+    def __init__(self, screen, log):
+        self.screen = screen
+        self.log = log
+        self.buf = bytearray()
+
+    def feed(self, data):
+        """返回这次收到了几个包"""
+        self.buf += data
+        buf = self.buf
+        i = 0
+        got = 0
+        while True:
+            j = buf.find(b'\xa5\x5a', i)
+            if j < 0:
+                keep = len(buf) - 1 if buf.endswith(b'\xa5') else len(buf)
+                self.log(buf[i:keep])
+                i = keep
+                break
+            self.log(buf[i:j])
+            i = j
+            if len(buf) < j + 4:
+                break
+            n = buf[j + 2] | buf[j + 3] << 8
+            if n < 2 or n > MAX_LEN:
+                self.log(buf[j:j + 1])
+                i = j + 1
+                continue
+            if len(buf) < j + 5 + n:
+                break
+            data = bytes(buf[j + 4:j + 4 + n])
+            if (~sum(data)) & 0xff != buf[j + 4 + n]:
+                self.screen.bad += 1
+                self.log(buf[j:j + 1])
+                i = j + 1
+                continue
+            self.screen.packet(data)
+            got += 1
+            i = j + 5 + n
+        del buf[:i]
+        return got
+
+
+def open_serial(path, baud):
+    import termios
+    fd = os.open(path, os.O_RDONLY | os.O_NOCTTY)
+    attr = termios.tcgetattr(fd)
+    speed = getattr(termios, 'B%d' % baud, None)
+    if speed is None:
+        sys.exit('mirror: unsupported baud rate %d' % baud)
+    attr[0] = 0                                     # iflag
+    attr[1] = 0                                     # oflag
+    attr[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+    attr[3] = 0                                     # lflag
+    attr[4] = attr[5] = speed
+    attr[6][termios.VMIN] = 1
+    attr[6][termios.VTIME] = 0
+    termios.tcsetattr(fd, termios.TCSANOW, attr)
+    return fd
+
+
+def main():
+    args = sys.argv[1:]
+    baud = 115200
+    pbm = None
+    while len(args) > 1 and args[0] in ('-b', '-p'):
+        if args[0] == '-b':
+            baud = int(args[1])
+        else:
+            pbm = args[1]
+        args = args[2:]
+    if len(args) != 1:
+        sys.exit(__doc__)
+    path = args[0]
+
+    screen = Screen()
+    if path == '-':
+        fd = sys.stdin.fileno()
+    elif os.path.exists(path) and not os.path.isfile(path):
+        fd = open_serial(path, baud)
+    else:
+        fd = os.open(path, os.O_RDONLY)
+    live = not os.path.isfile(path) and sys.stdout.isatty()
+    lines = []
+    text = bytearray()
+
+    def log(data):
+        text.extend(data)
+        while b'\n' in text:
+            k = text.index(b'\n')
+            line = text[:k].decode('utf-8', 'replace').rstrip('\r')
+            del text[:k + 1]
+            if live:
+                lines.append(line)
+                del lines[:-8]
+            else:
+                print(line)
+
+    parser = Parser(screen, log)
+    if live:
+        sys.stdout.write('\033[2J')
+    try:
+        while True:
+            data = os.read(fd, 4096)
+            if not data:
+                break
+            if parser.feed(data) and live:
+                # 光标回左上角重画，下面留8行给PRINTF
+                sys.stdout.write('\033[H%s\n#%d packets %d lost %d bad %d\033[K\n%s\033[J'
+                                 % (screen.text(), screen.seq, screen.packets, screen.lost,
+                                    screen.bad, '\n'.join(l + '\033[K' for l in lines)))
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    log(b'\n' if text else b'')
+
+    if not live:
+        print(screen.text())
+    print('mirror: %d packets, %d lost, %d bad' % (screen.packets, screen.lost, screen.bad),
+          file=sys.stderr)
+    if pbm:
+        with open(pbm, 'w') as f:
+            f.write(screen.pbm())
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""
+把XBM图标转换成SSD1306的tile格式(竖排字节，低位在上)，生成 Icon.c / Icon.h
+
+  python tools/xbm2tile.py Hardware Hardware/Icon/ele.xbm Hardware/Icon/lin.xbm
+
+输出的数组按 (h+7)/8 页排列，每页 w 字节，用 u8g2_DrawTileBitmap 画。
+所有图标要一样大，数组下标就是命令行里的顺序。
+Keil的 Before Build 会运行它(和fontsubset.py一样)，输出文件内容没变时不重写，避免每次都重新编译。
+"""
+import os
+import re
+import sys
+
+
+def read_xbm(path):
+    text = open(path).read()
+    w = int(re.search(r'#define\s+\w*_width\s+(\d+)', text).group(1))
+    h = int(re.search(r'#define\s+\w*_height\s+(\d+)', text).group(1))
+    body = text[text.index('{') + 1:text.index('}')]
+    data = [int(v, 16) for v in re.findall(r'0x[0-9a-fA-F]+', body)]
+    if len(data) != (w + 7) // 8 * h:
+        sys.exit('%s: %d bytes, expected %d' % (path, len(data), (w + 7) // 8 * h))
+    return w, h, data
+
+
+def xbm_to_tile(w, h, data):
+    # XBM: 每行 (w+7)/8 字节，横排，低位在左
+    stride = (w + 7) // 8
+    out = []
+    for page in range((h + 7) // 8):
+        for x in range(w):
+            b = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < h and data[y * stride + x // 8] & (1 << (x & 7)):
+                    b |= 1 << bit
+            out.append(b)
+    return out
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append('        ' + ','.join('0x%02X' % v for v in data[i:i + 16]))
+    return ',\r\n'.join(lines)
+
+
+def write_if_changed(path, data):
+    try:
+        if open(path, 'rb').read() == data:
+            return
+    except OSError:
+        pass
+    with open(path, 'wb') as f:
+        f.write(data)
+    print('xbm2tile: %s' % path)
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    out_dir = sys.argv[1]
+    icons = []
+    for path in sys.argv[2:]:
+        w, h, data = read_xbm(path)
+        icons.append((os.path.splitext(os.path.basename(path))[0], w, h, xbm_to_tile(w, h, data)))
+    w, h = icons[0][1], icons[0][2]
+    for name, iw, ih, _ in icons:
+        if (iw, ih) != (w, h):
+            sys.exit('%s: %dx%d, expected %dx%d' % (name, iw, ih, w, h))
+    size = w * ((h + 7) // 8)
+
+    hdr = [
+        '//由 tools/xbm2tile.py 生成，不要手改',
+        '#ifndef ICON_H',
+        '#define ICON_H',
+        '',
+        '#define ICON_WIDTH  %d' % w,
+        '#define ICON_HEIGHT %d' % h,
+        '#define ICON_NUM    %d' % len(icons),
+        '',
+        '//tile格式: %d页 每页%d字节 竖排低位在上，和SSD1306显存一样' % ((h + 7) // 8, w),
+        'extern const unsigned char ICON_Tile[ICON_NUM][%d];' % size,
+        '',
+        '#endif',
+        '',
+    ]
+    src = [
+        '//由 tools/xbm2tile.py 生成，不要手改',
+        '#include "Icon.h"',
+        '',
+        'const unsigned char ICON_Tile[ICON_NUM][%d] =' % size,
+        '{',
+    ]
+    for i, (name, _, _, data) in enumerate(icons):
+        src.append('    {')
+        src.append(c_array(data))
+        src.append('    }%s//%s' % (',' if i + 1 < len(icons) else '', name))
+    src += ['};', '']
+
+    for name, lines in (('Icon.h', hdr), ('Icon.c', src)):
+        write_if_changed(os.path.join(out_dir, name), '\r\n'.join(lines).encode('utf-8'))
+
+
+if __name__ == '__main__':
+    main()